@@ -0,0 +1,132 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   affinity.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:36:31 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:37:46 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#define _GNU_SOURCE
+#include "philo.h"
+#include <sched.h> // sched_getaffinity(), cpu_set_t, CPU_SET()
+
+/**
+ * @brief Reads a sysfs CPU list such as "0-3,8-11" into a CPU set.
+ * 
+ * @param path The file to read.
+ * @param set Receives the listed CPUs.
+ * @return SUCCESS, or FAILURE if the file does not exist.
+ */
+static int	read_cpu_list(const char *path, cpu_set_t *set)
+{
+	FILE	*file;
+	int		first;
+	int		last;
+	char	separator;
+
+	CPU_ZERO(set);
+	file = fopen(path, "r");
+	if (!file)
+		return (FAILURE);
+	while (fscanf(file, "%d", &first) == 1)
+	{
+		last = first;
+		separator = fgetc(file);
+		if (separator == '-' && fscanf(file, "%d", &last) == 1)
+			separator = fgetc(file);
+		while (first <= last && first < CPU_SETSIZE)
+			CPU_SET(first++, set);
+		if (separator != ',')
+			break ;
+	}
+	fclose(file);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Appends the allowed CPUs of one node to the placement list.
+ * 
+ * Appended CPUs are removed from `allowed`, so a CPU is listed once.
+ * 
+ * @param affinity The list being built.
+ * @param allowed CPUs the process may run on and that are not listed yet.
+ * @param node_cpus CPUs of the node, or every CPU for the leftovers.
+ * @param node The node, or -1 for the leftovers.
+ */
+static void	append_cpus(t_affinity *affinity, cpu_set_t *allowed,
+		cpu_set_t *node_cpus, int node)
+{
+	int	cpu;
+	int	appended;
+
+	cpu = -1;
+	appended = FALSE;
+	while (++cpu < CPU_SETSIZE)
+	{
+		if (!CPU_ISSET(cpu, allowed) || !CPU_ISSET(cpu, node_cpus))
+			continue ;
+		affinity->cpus[affinity->count] = cpu;
+		affinity->nodes[affinity->count++] = node;
+		CPU_CLR(cpu, allowed);
+		appended = TRUE;
+	}
+	affinity->node_count += appended;
+}
+
+/**
+ * @brief Lists the CPUs the process may run on, grouped by NUMA node, for
+ *        `--pin`.
+ * 
+ * Nodes come from /sys/devices/system/node; CPUs that no node claims, or
+ * every CPU if there is no such directory, are appended with node -1.
+ * Without `--pin` nothing is done and the kernel places every thread.
+ * 
+ * @param sim The simulation being prepared.
+ * @return SUCCESS, or FAILURE if the CPU mask or memory is unavailable.
+ */
+int	affinity_init(t_simulation *sim)
+{
+	t_affinity	*affinity;
+	cpu_set_t	allowed;
+	cpu_set_t	node_cpus;
+	char		path[64];
+	int			node;
+
+	affinity = &sim->affinity;
+	memset(affinity, 0, sizeof(t_affinity));
+	if (!sim->options.pin)
+		return (SUCCESS);
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) != SUCCESS)
+		return (print_error("Error: Cannot read the CPU affinity mask.\n"));
+	affinity->cpus = malloc(sizeof(int) * CPU_COUNT(&allowed));
+	affinity->nodes = malloc(sizeof(int) * CPU_COUNT(&allowed));
+	if (!affinity->cpus || !affinity->nodes)
+		return (print_error("Error: Memory allocation failed\n"));
+	node = -1;
+	while (++node < AFFINITY_MAX_NODES)
+	{
+		snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist",
+			node);
+		if (read_cpu_list(path, &node_cpus) == SUCCESS)
+			append_cpus(affinity, &allowed, &node_cpus, node);
+	}
+	memset(&node_cpus, 0xff, sizeof(node_cpus));
+	append_cpus(affinity, &allowed, &node_cpus, -1);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Frees the placement list built by affinity_init().
+ * 
+ * @param sim The simulation.
+ */
+void	affinity_destroy(t_simulation *sim)
+{
+	free(sim->affinity.cpus);
+	free(sim->affinity.nodes);
+	memset(&sim->affinity, 0, sizeof(t_affinity));
+}
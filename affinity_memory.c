@@ -0,0 +1,109 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   affinity_memory.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:36:50 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:53:32 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+#include <linux/mempolicy.h> // MPOL_PREFERRED, MPOL_MF_MOVE
+#include <sys/syscall.h> // SYS_mbind
+#include <stdint.h> // uintptr_t
+
+/**
+ * @brief Returns the node of the thread that runs a philosopher.
+ * 
+ * @param sim The simulation.
+ * @param index Index of the philosopher.
+ * @return The node, or -1 if it is unknown.
+ */
+static int	philosopher_node(t_simulation *sim, int index)
+{
+	if (sim->options.engine != ENGINE_THREADS)
+		return (affinity_slot_node(sim, sim->pool.tasks[index].worker
+				- sim->pool.workers, sim->pool.worker_count));
+	return (affinity_slot_node(sim, index, sim->philosopher_count));
+}
+
+/**
+ * @brief Asks the kernel to keep a memory range on one node.
+ * 
+ * The range is widened to whole pages, so a page straddling two ranges
+ * goes to the node bound last. MPOL_MF_MOVE migrates the pages setup has
+ * already touched. This is a hint: failures (no NUMA support, a container
+ * without the permission) are ignored.
+ * 
+ * @param start First byte of the range.
+ * @param length Length of the range in bytes.
+ * @param node The node.
+ */
+static void	bind_pages(void *start, size_t length, int node)
+{
+	unsigned long	mask;
+	uintptr_t		first;
+	uintptr_t		end;
+	uintptr_t		page;
+
+	page = sysconf(_SC_PAGESIZE);
+	first = (uintptr_t)start & ~(page - 1);
+	end = ((uintptr_t)start + length + page - 1) & ~(page - 1);
+	mask = 1UL << node;
+	syscall(SYS_mbind, (void *)first, end - first, MPOL_PREFERRED, &mask,
+		sizeof(mask) * CHAR_BIT, MPOL_MF_MOVE);
+}
+
+/**
+ * @brief Binds the state of a run of philosophers sharing a node.
+ * 
+ * @param sim The simulation.
+ * @param first Index of the first philosopher of the run.
+ * @param end Index one past the last philosopher of the run.
+ * @param node The node their threads run on.
+ */
+static void	bind_run(t_simulation *sim, int first, int end, int node)
+{
+	if (node < 0)
+		return ;
+	bind_pages(&sim->seats[first], sizeof(t_seat) * (end - first), node);
+	bind_pages(&sim->philosophers[first],
+		sizeof(t_philosopher) * (end - first), node);
+	if (sim->options.engine != ENGINE_THREADS)
+		bind_pages(&sim->pool.tasks[first], sizeof(t_task) * (end - first),
+			node);
+}
+
+/**
+ * @brief Moves each philosopher's seat (meal state and left fork),
+ *        philosopher entry and pool task to the node their thread is
+ *        pinned to with `--pin`.
+ * 
+ * Does nothing unless the pinned CPUs span several nodes.
+ * 
+ * @param sim A prepared simulation whose threads are not started yet.
+ */
+void	affinity_bind_memory(t_simulation *sim)
+{
+	int	first;
+	int	node;
+	int	i;
+
+	if (sim->affinity.node_count < 2)
+		return ;
+	first = 0;
+	node = philosopher_node(sim, 0);
+	i = 0;
+	while (++i <= sim->philosopher_count)
+	{
+		if (i < sim->philosopher_count && philosopher_node(sim, i) == node)
+			continue ;
+		bind_run(sim, first, i, node);
+		first = i;
+		if (i < sim->philosopher_count)
+			node = philosopher_node(sim, i);
+	}
+}
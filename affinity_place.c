@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   affinity_place.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:36:50 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:42:30 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#define _GNU_SOURCE
+#include "philo.h"
+#include <sched.h> // cpu_set_t, CPU_SET()
+
+/**
+ * @brief Returns the NUMA node of one of `total` threads placed by `--pin`.
+ * 
+ * Thread `index` gets entry `index * count / total` of the CPU list, so
+ * the threads are spread evenly and each contiguous range of the ring
+ * shares a node.
+ * 
+ * @param sim The simulation.
+ * @param index Index of the thread: the philosopher or the worker.
+ * @param total Number of such threads.
+ * @return The node, or -1 without `--pin` or if it is unknown.
+ */
+int	affinity_slot_node(t_simulation *sim, int index, int total)
+{
+	if (sim->affinity.count == 0)
+		return (-1);
+	return (sim->affinity.nodes[(long long)index * sim->affinity.count
+			/ total]);
+}
+
+/**
+ * @brief Pins one of `total` threads to its CPU with `--pin`.
+ * 
+ * The thread is created on the CPU chosen as in affinity_slot_node(), so
+ * its first instructions already run there. Without `--pin` the
+ * attributes are left alone.
+ * 
+ * @param sim The simulation.
+ * @param index Index of the thread: the philosopher or the worker.
+ * @param total Number of such threads.
+ * @param attr The thread's initialized attributes.
+ * @return SUCCESS, or FAILURE after printing an error message.
+ */
+int	affinity_pin(t_simulation *sim, int index, int total,
+		pthread_attr_t *attr)
+{
+	cpu_set_t	cpu;
+
+	if (sim->affinity.count == 0)
+		return (SUCCESS);
+	CPU_ZERO(&cpu);
+	CPU_SET(sim->affinity.cpus[(long long)index * sim->affinity.count
+		/ total], &cpu);
+	if (pthread_attr_setaffinity_np(attr, sizeof(cpu), &cpu) != SUCCESS)
+		return (print_error("Error: Thread affinity setup failed.\n"));
+	return (SUCCESS);
+}
+
+/**
+ * @brief Moves the calling thread to its CPU with `--pin`.
+ * 
+ * For a thread that outlives one simulation, such as a `--batch` worker,
+ * whose place depends on each run's `total`. A failure leaves the thread
+ * where it was.
+ * 
+ * @param sim The simulation.
+ * @param index Index of the thread: the philosopher or the worker.
+ * @param total Number of such threads.
+ */
+void	affinity_pin_self(t_simulation *sim, int index, int total)
+{
+	cpu_set_t	cpu;
+
+	if (sim->affinity.count == 0)
+		return ;
+	CPU_ZERO(&cpu);
+	CPU_SET(sim->affinity.cpus[(long long)index * sim->affinity.count
+		/ total], &cpu);
+	pthread_setaffinity_np(pthread_self(), sizeof(cpu), &cpu);
+}
@@ -0,0 +1,102 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   arena.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:38:34 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:27:08 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+#include <sys/mman.h> // mmap(), munmap(), madvise()
+
+/**
+ * @brief Returns how much of an arena a block of `size` bytes takes.
+ * 
+ * @param size Requested size in bytes.
+ * @return `size` rounded up to ARENA_ALIGN.
+ */
+size_t	arena_span(size_t size)
+{
+	return ((size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1));
+}
+
+/**
+ * @brief Maps an arena of `size` bytes.
+ * 
+ * @param arena The arena to create.
+ * @param size The sum of the arena_span() of every block it will hold.
+ * @return SUCCESS, or FAILURE after printing an error message.
+ */
+int	arena_init(t_arena *arena, size_t size)
+{
+	arena->used = 0;
+	arena->size = size;
+	arena->base = mmap(NULL, size, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (arena->base == MAP_FAILED)
+	{
+		arena->base = NULL;
+		return (print_error("Error: Memory allocation failed\n"));
+	}
+	return (SUCCESS);
+}
+
+/**
+ * @brief Empties an arena for a new simulation, keeping its mapping if it
+ *        is large enough.
+ * 
+ * MADV_DONTNEED drops the pages the last simulation touched, so they read
+ * as zero again and only cost a page fault when touched anew; a mapping
+ * that is too small is replaced.
+ * 
+ * @param arena The arena; may never have been mapped.
+ * @param size The size the new simulation needs, as for arena_init().
+ * @return SUCCESS, or FAILURE after printing an error message.
+ */
+int	arena_reuse(t_arena *arena, size_t size)
+{
+	if (!arena->base || size > arena->size)
+	{
+		arena_destroy(arena);
+		return (arena_init(arena, size));
+	}
+	madvise(arena->base, arena->size, MADV_DONTNEED);
+	arena->used = 0;
+	return (SUCCESS);
+}
+
+/**
+ * @brief Hands out the next zeroed, cache-line-aligned block.
+ * 
+ * @param arena The arena.
+ * @param size Size of the block in bytes.
+ * @return The block, or NULL if the arena was sized too small.
+ */
+void	*arena_alloc(t_arena *arena, size_t size)
+{
+	void	*block;
+
+	if (!arena->base || arena_span(size) > arena->size - arena->used)
+		return (NULL);
+	block = arena->base + arena->used;
+	arena->used += arena_span(size);
+	return (block);
+}
+
+/**
+ * @brief Unmaps the arena and everything allocated from it.
+ * 
+ * @param arena The arena; may never have been mapped.
+ */
+void	arena_destroy(t_arena *arena)
+{
+	if (arena->base)
+		munmap(arena->base, arena->size);
+	arena->base = NULL;
+	arena->size = 0;
+	arena->used = 0;
+}
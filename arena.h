@@ -0,0 +1,44 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   arena.h                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:38:34 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:27:08 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef ARENA_H
+# define ARENA_H
+
+# include <stddef.h> // size_t
+
+# define ARENA_ALIGN 64 // < Every block starts on its own cache line.
+
+/**
+ * @brief One mapping that holds all the state of a simulation.
+ * 
+ * The size is computed up front, the mapping is made once and blocks are
+ * handed out by bumping `used`; nothing is freed individually, the whole
+ * mapping goes away in arena_destroy(), or is emptied for the next run of
+ * a `--batch` by arena_reuse(). Pages come from the kernel zeroed
+ * and are only backed once touched, so unused capacity (log rings, stacks)
+ * costs address space rather than memory.
+ */
+typedef struct s_arena
+{
+	char	*base; // < Start of the mapping, page-aligned; NULL if none.
+	size_t	size; // < Length of the mapping.
+	size_t	used; // < Bytes handed out so far.
+}	t_arena;
+
+// arena.c
+size_t	arena_span(size_t size);
+int		arena_init(t_arena *arena, size_t size);
+int		arena_reuse(t_arena *arena, size_t size);
+void	*arena_alloc(t_arena *arena, size_t size);
+void	arena_destroy(t_arena *arena);
+
+#endif
@@ -0,0 +1,185 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:25:30 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:29:20 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Splits the current line in place into the positional arguments,
+ *        dropping a `#` comment.
+ * 
+ * @param batch The batch whose `line` was just read.
+ * @return The argument count plus one for argv[0], as for main(): 1 for
+ *         a blank line, more than BATCH_MAX_ARGS for too many arguments.
+ */
+static int	batch_split(t_batch *batch)
+{
+	char	*cursor;
+
+	batch->argv[0] = "philo";
+	batch->argc = 1;
+	cursor = batch->line;
+	while (*cursor)
+	{
+		if (*cursor == '#')
+			*cursor = '\0';
+		else if (*cursor == ' ' || *cursor == '\t' || *cursor == '\r'
+			|| *cursor == '\n')
+			*cursor++ = '\0';
+		else
+		{
+			if (batch->argc <= BATCH_MAX_ARGS)
+				batch->argv[batch->argc++] = cursor;
+			while (*cursor && *cursor != ' ' && *cursor != '\t'
+				&& *cursor != '\r' && *cursor != '\n')
+				cursor++;
+		}
+	}
+	return (batch->argc);
+}
+
+/**
+ * @brief Tells whether the line just read is complete, and if not,
+ *        skips the rest of it.
+ * 
+ * A line longer than BATCH_LINE_MAX does not fit in `line`; fgets()
+ * then returns it without its newline and would return the rest as the
+ * next line, so the rest is read and dropped instead.
+ * 
+ * @param batch The batch whose `line` was just read.
+ * @param input The batch input.
+ * @return TRUE (=1) if the line fits, FALSE (=0) if it was too long.
+ */
+static int	batch_line_fits(t_batch *batch, FILE *input)
+{
+	int	c;
+
+	if (strchr(batch->line, '\n') || feof(input))
+		return (TRUE);
+	c = fgetc(input);
+	while (c != EOF && c != '\n')
+		c = fgetc(input);
+	return (FALSE);
+}
+
+/**
+ * @brief Writes the header that separates one run's output from the next:
+ *        `#` and the run's arguments.
+ * 
+ * It is flushed before the run starts, as the log writer writes to the
+ * file descriptor directly.
+ * 
+ * @param batch The batch about to run its current line.
+ */
+static void	batch_announce(t_batch *batch)
+{
+	int	i;
+
+	printf("#");
+	i = 0;
+	while (++i < batch->argc)
+		printf(" %s", batch->argv[i]);
+	printf("\n");
+	fflush(stdout);
+}
+
+/**
+ * @brief Runs the configuration of the current line to its end.
+ * 
+ * It runs like a single simulation, except that its arena is taken over
+ * from the previous run and handed back to the batch before the rest is
+ * released, so the mapping outlives the run. With `--engine=pool` its
+ * workers run on the batch's crew, parked again once the run is over.
+ * 
+ * @param batch The batch, with its current line split.
+ * @return SUCCESS (=0), or FAILURE (=1) if the line did not run.
+ */
+static int	batch_run(t_batch *batch)
+{
+	t_simulation	sim;
+	int				status;
+
+	memset(&sim, 0, sizeof(t_simulation));
+	sim.options = *batch->options;
+	if (parse_cmd_line_args(&sim, batch->argc, batch->argv) != SUCCESS)
+		return (FAILURE);
+	sim.arena = batch->arena;
+	batch->arena.base = NULL;
+	if (sim.options.engine == ENGINE_POOL)
+		sim.crew = &batch->crew;
+	status = prepare_simulation(&sim);
+	if (status == SUCCESS)
+		status = launch_philosopher_threads(&sim);
+	if (status != SUCCESS)
+		end_simulation(&sim);
+	start_gate_open(&sim);
+	if (status == SUCCESS)
+		monitor_simulation(&sim);
+	join_simulation_threads(&sim);
+	if (status == SUCCESS)
+		log_summary(&sim);
+	batch->arena = sim.arena;
+	sim.arena.base = NULL;
+	release_simulation_resources(&sim);
+	return (status);
+}
+
+/**
+ * @brief Runs one simulation per line of `--batch` input, one after the
+ *        other in this process; with `--output=summary` each run prints
+ *        just its outcome.
+ * 
+ * Each line holds the positional arguments of one run, e.g.
+ * `5 800 200 200 7`, and every run uses the process's `--options`. Blank
+ * lines and `#` comments are skipped. A line that does not run, or is
+ * longer than BATCH_LINE_MAX, is reported and the batch goes on, but
+ * ends with FAILURE. The arena (and
+ * with it the thread stacks of `--stack-size`) is mapped once and reused
+ * by every run that fits in it, and `--engine=pool` workers are created
+ * once and parked between runs; only the per-run state is set up anew.
+ * 
+ * @param options The parsed options; `batch_path` is set.
+ * @return SUCCESS (=0) if every line ran, otherwise FAILURE (=1).
+ */
+int	run_batch(const t_options *options)
+{
+	t_batch	batch;
+	FILE	*input;
+
+	memset(&batch, 0, sizeof(t_batch));
+	batch.options = options;
+	input = stdin;
+	if (strcmp(options->batch_path, "-") != 0)
+		input = fopen(options->batch_path, "r");
+	if (!input)
+		return (print_error("Error: Cannot read the batch file.\n"));
+	while (fgets(batch.line, BATCH_LINE_MAX, input))
+	{
+		if (!batch_line_fits(&batch, input))
+		{
+			print_error("Error: Batch line too long.\n");
+			batch.failures++;
+			continue ;
+		}
+		if (batch_split(&batch) == 1)
+			continue ;
+		batch_announce(&batch);
+		if (batch_run(&batch) != SUCCESS)
+			batch.failures++;
+	}
+	if (input != stdin)
+		fclose(input);
+	crew_destroy(&batch.crew);
+	arena_destroy(&batch.arena);
+	if (batch.failures)
+		return (FAILURE);
+	return (SUCCESS);
+}
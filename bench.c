@@ -0,0 +1,168 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:46:04 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:23:54 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Returns the benchmark matrix.
+ * 
+ * The matrix covers small, medium and large tables, odd and even counts,
+ * slack and tight timings, and two configurations that are expected to end
+ * with a death so that detection latency gets measured.
+ * 
+ * @param count Receives the number of configurations.
+ * @return A pointer to the first entry of the static table.
+ */
+static const t_bench_config	*bench_matrix(int *count)
+{
+	static const t_bench_config	matrix[] = {
+	{5, 800, 200, 200, -1, BENCH_RUN_MS},
+	{5, 610, 200, 200, -1, BENCH_RUN_MS},
+	{50, 800, 200, 200, -1, BENCH_RUN_MS},
+	{199, 800, 200, 200, -1, BENCH_RUN_MS},
+	{200, 800, 200, 200, -1, BENCH_RUN_MS},
+	{200, 410, 200, 200, -1, BENCH_RUN_MS},
+	{31, 250, 60, 60, -1, BENCH_RUN_MS},
+	{4, 310, 200, 100, -1, BENCH_RUN_MS},
+	{1, 400, 100, 100, -1, BENCH_RUN_MS}
+	};
+
+	*count = sizeof(matrix) / sizeof(matrix[0]);
+	return (matrix);
+}
+
+/**
+ * @brief Runs one configuration with output suppressed and measures it.
+ * 
+ * The run ends when a philosopher dies, when everyone has eaten
+ * `required_meals` times or after the configuration's time limit,
+ * whichever comes first. The sweep (sweep.c) runs its configurations
+ * through here too. Measurements are taken after the threads are joined and
+ * before the resources are released.
+ * 
+ * @param options The options the benchmark was started with.
+ * @param config The configuration to run.
+ * @param result Receives the measurements.
+ * @return Returns SUCCESS (=0) if the run completed, otherwise FAILURE (=1).
+ */
+int	bench_run(const t_options *options, const t_bench_config *config,
+	t_bench_result *result)
+{
+	t_simulation	sim;
+	long long		elapsed;
+
+	memset(&sim, 0, sizeof(t_simulation));
+	sim.options = *options;
+	sim.options.quiet = TRUE;
+	sim.options.trace_path = NULL;
+	sim.philosopher_count = config->philosopher_count;
+	sim.time_to_die = config->time_to_die;
+	sim.time_to_eat = config->time_to_eat;
+	sim.time_to_sleep = config->time_to_sleep;
+	sim.required_meals = config->required_meals;
+	sim.time_limit_ms = config->time_limit_ms;
+	if (prepare_simulation(&sim) != SUCCESS
+		|| launch_philosopher_threads(&sim) != SUCCESS)
+	{
+		abort_simulation(&sim);
+		return (FAILURE);
+	}
+	monitor_simulation(&sim);
+	elapsed = simulation_time(&sim) - sim.sim_start_time;
+	join_simulation_threads(&sim);
+	bench_collect(&sim, result, elapsed);
+	release_simulation_resources(&sim);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Prints a latency in microseconds, or "-" if it was not measured.
+ * 
+ * @param nanoseconds The latency, negative when absent.
+ */
+static void	print_latency(long long nanoseconds)
+{
+	if (nanoseconds < 0)
+		printf(" %9s", "-");
+	else
+		printf(" %9.1f", (double)nanoseconds / NS_PER_US);
+}
+
+/**
+ * @brief Prints one row of the benchmark table.
+ * 
+ * @param config The configuration that was run.
+ * @param result Its measurements.
+ */
+static void	print_result(const t_bench_config *config,
+	const t_bench_result *result)
+{
+	printf("%5d %5d %5d %5d | %9.1f", config->philosopher_count,
+		config->time_to_die, config->time_to_eat, config->time_to_sleep,
+		result->meals_per_sec);
+	if (result->efficiency < 0)
+		printf(" %5s", "-");
+	else
+		printf(" %5.1f", result->efficiency * 100);
+	printf(" %5d %5d %7.2f |", result->min_meals, result->max_meals,
+		result->meals_stddev);
+	print_latency(result->fork_wait_p50);
+	print_latency(result->fork_wait_p99);
+	print_latency(result->fork_wait_max);
+	if (result->hunger_max < 0)
+		printf(" %7s", "-");
+	else
+		printf(" %7.1f", (double)(ms_to_ns(config->time_to_die)
+				- result->hunger_max) / NS_PER_MS);
+	printf(" |");
+	print_latency(result->death_latency);
+	printf("\n");
+}
+
+/**
+ * @brief Runs the whole benchmark matrix and prints one row per entry.
+ * 
+ * Columns: configuration (N, die, eat, sleep), meals per second and their
+ * share of the theoretical maximum, fewest and most meals per philosopher
+ * with the standard deviation, fork-wait latency p50/p99/max, the worst
+ * slack (`time_to_die` minus the longest time between two meals, in ms)
+ * and death-detection latency, all latencies in microseconds. Fork waits
+ * and slack are measured only by PHILO_STATS builds (`make bench`), so
+ * `--bench --strategy=schedule` can be held against the mutex strategies.
+ * 
+ * @param options The parsed command-line options.
+ * @return Returns SUCCESS (=0) if every run completed, otherwise FAILURE (=1).
+ */
+int	run_benchmark(const t_options *options)
+{
+	const t_bench_config	*matrix;
+	t_bench_result			result;
+	int						count;
+	int						i;
+
+	if (!PHILO_STATS)
+		print_error("Warning: fork waits need a PHILO_STATS build "
+			"(make bench).\n");
+	matrix = bench_matrix(&count);
+	printf("%5s %5s %5s %5s | %9s %5s %5s %5s %7s | %9s %9s %9s %7s | %9s\n",
+		"N", "die", "eat", "sleep", "meals/s", "eff%", "min", "max", "stddev",
+		"wait p50", "wait p99", "wait max", "slack", "death");
+	i = -1;
+	while (++i < count)
+	{
+		if (bench_run(options, &matrix[i], &result) != SUCCESS)
+			return (FAILURE);
+		print_result(&matrix[i], &result);
+		fflush(stdout);
+	}
+	return (SUCCESS);
+}
@@ -0,0 +1,160 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_stats.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:45:53 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:23:54 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+#include <math.h> // sqrt()
+
+/**
+ * @brief Returns Jain's fairness index `(sum x)^2 / (N * sum x^2)`.
+ * 
+ * It is 1 when everyone ate equally often, down to 1/N when one
+ * philosopher ate every meal, and 1 when nobody ate.
+ * 
+ * @param sum Sum of the meal counts.
+ * @param square_sum Sum of their squares.
+ * @param count Number of philosophers.
+ * @return The index, between 1/N and 1.
+ */
+static double	jain_index(double sum, double square_sum, int count)
+{
+	if (square_sum <= 0)
+		return (1);
+	return (sum * sum / (count * square_sum));
+}
+
+/**
+ * @brief Computes meal throughput and per-philosopher fairness.
+ * 
+ * @param sim A simulation whose threads have been joined.
+ * @param result Receives meals/second, min/max meals, their deviation and
+ *               the fairness index.
+ * @param elapsed_ns Duration of the run in nanoseconds.
+ */
+static void	collect_meals(t_simulation *sim, t_bench_result *result,
+	long long elapsed_ns)
+{
+	int		i;
+	int		meals;
+	double	sum;
+	double	square_sum;
+
+	sum = 0;
+	square_sum = 0;
+	result->min_meals = INT_MAX;
+	result->max_meals = 0;
+	i = -1;
+	while (++i < sim->philosopher_count)
+	{
+		meals = get_meals_eaten(&sim->philosophers[i]);
+		if (meals < result->min_meals)
+			result->min_meals = meals;
+		if (meals > result->max_meals)
+			result->max_meals = meals;
+		sum += meals;
+		square_sum += (double)meals * meals;
+	}
+	result->meals_stddev = sqrt(square_sum / sim->philosopher_count
+			- (sum / sim->philosopher_count) * (sum / sim->philosopher_count));
+	result->fairness = jain_index(sum, square_sum, sim->philosopher_count);
+	result->meals_per_sec = sum * NS_PER_SEC / elapsed_ns;
+}
+
+/**
+ * @brief Merges every philosopher's fork-wait histogram and reads the
+ *        percentiles, and finds the longest anyone went without a meal.
+ * 
+ * @param sim A simulation whose threads have been joined.
+ * @param result Receives the p50/p99/max fork wait and the longest time
+ *               between meals, whose difference to `time_to_die` is the
+ *               run's worst slack, all -1 when not measured (or, for
+ *               the latter, when nobody ate).
+ */
+static void	collect_fork_waits(t_simulation *sim, t_bench_result *result)
+{
+	t_histogram	*merged;
+	int			i;
+
+	result->fork_wait_p50 = -1;
+	result->fork_wait_p99 = -1;
+	result->fork_wait_max = -1;
+	result->hunger_max = -1;
+	merged = calloc(1, sizeof(t_histogram));
+	if (!merged || !sim->stats)
+	{
+		free(merged);
+		return ;
+	}
+	i = -1;
+	while (++i < sim->philosopher_count)
+	{
+		histogram_merge(merged, &sim->stats[i].fork_wait);
+		if (sim->stats[i].hunger_max_ns > result->hunger_max)
+			result->hunger_max = sim->stats[i].hunger_max_ns;
+	}
+	result->fork_wait_p50 = histogram_percentile(merged, 0.50);
+	result->fork_wait_p99 = histogram_percentile(merged, 0.99);
+	result->fork_wait_max = histogram_percentile(merged, 1.0);
+	free(merged);
+}
+
+/**
+ * @brief Returns the most meals a configuration allows in a run.
+ * 
+ * At most `N / 2` philosophers hold two forks at a time, each for
+ * `time_to_eat`, and no philosopher starts a meal more often than once per
+ * `time_to_eat + time_to_sleep`; the tighter bound wins. Meals are counted
+ * when they start, so a meal started just before the end counts too.
+ * 
+ * @param sim The simulation.
+ * @param elapsed_ns Duration of the run in nanoseconds.
+ * @return The number of meals, 0 when nobody can eat (one philosopher).
+ */
+static long long	theoretical_meals(t_simulation *sim, long long elapsed_ns)
+{
+	long long	by_forks;
+	long long	by_cycle;
+
+	by_forks = (sim->philosopher_count / 2)
+		* (elapsed_ns / ms_to_ns(sim->time_to_eat) + 1);
+	by_cycle = sim->philosopher_count * (elapsed_ns
+			/ ms_to_ns(sim->time_to_eat + sim->time_to_sleep) + 1);
+	if (by_cycle < by_forks)
+		return (by_cycle);
+	return (by_forks);
+}
+
+/**
+ * @brief Fills in a benchmark result from a finished simulation.
+ * 
+ * @param sim A simulation whose threads have been joined.
+ * @param result Receives all measurements, including the throughput as a
+ *               share of theoretical_meals(), which is only meaningful
+ *               (and only set) if the run was not cut short by a death.
+ * @param elapsed_ns Duration of the run in nanoseconds.
+ */
+void	bench_collect(t_simulation *sim, t_bench_result *result,
+	long long elapsed_ns)
+{
+	long long	max_meals;
+
+	collect_meals(sim, result, elapsed_ns);
+	max_meals = theoretical_meals(sim, elapsed_ns);
+	result->efficiency = -1;
+	if (max_meals > 0 && sim->death_latency_ns < 0)
+		result->efficiency = result->meals_per_sec * elapsed_ns / NS_PER_SEC
+			/ max_meals;
+	collect_fork_waits(sim, result);
+	result->death_latency = sim->death_latency_ns;
+	result->death_time = -1;
+	if (sim->death_latency_ns >= 0)
+		result->death_time = sim->death_time - sim->sim_start_time;
+}
@@ -0,0 +1,102 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   deadline_heap.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:41:39 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:13:35 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Carves the deadline heap for `capacity` philosophers out of an
+ *        arena.
+ * 
+ * @param heap The heap to set up.
+ * @param arena The simulation's arena.
+ * @param capacity Number of philosophers it will track.
+ * @return Returns SUCCESS (=0) on success, otherwise prints an error message
+ *         and returns an error code.
+ */
+int	deadline_heap_init(t_deadline_heap *heap, t_arena *arena, int capacity)
+{
+	heap->entries = arena_alloc(arena, sizeof(t_deadline) * capacity);
+	heap->size = 0;
+	if (!heap->entries)
+		return (print_error("Error: Memory allocation failed\n"));
+	return (SUCCESS);
+}
+
+/**
+ * @brief Moves an entry down until no child has an earlier deadline.
+ * 
+ * @param heap The heap to update.
+ * @param slot Slot of the entry to move.
+ */
+static void	deadline_heap_sift_down(t_deadline_heap *heap, int slot)
+{
+	int			child;
+	t_deadline	swap;
+
+	while (2 * slot + 1 < heap->size)
+	{
+		child = 2 * slot + 1;
+		if (child + 1 < heap->size && heap->entries[child + 1].deadline
+			< heap->entries[child].deadline)
+			child++;
+		if (heap->entries[slot].deadline <= heap->entries[child].deadline)
+			break ;
+		swap = heap->entries[child];
+		heap->entries[child] = heap->entries[slot];
+		heap->entries[slot] = swap;
+		slot = child;
+	}
+}
+
+/**
+ * @brief Fills the heap with the current death deadlines of `heap->size`
+ *        philosophers, starting at philosopher `first`.
+ * 
+ * The deadline of philosopher `i` is `last_meal_time + time_to_die`.
+ * The array is heapified bottom-up in O(N).
+ * 
+ * @param heap The allocated heap, sized for the philosophers it tracks.
+ * @param sim The simulation whose philosophers are tracked.
+ * @param first Index of the first philosopher tracked.
+ */
+void	deadline_heap_build(t_deadline_heap *heap, t_simulation *sim,
+	int first)
+{
+	int	i;
+
+	i = -1;
+	while (++i < heap->size)
+	{
+		heap->entries[i].index = first + i;
+		heap->entries[i].deadline = get_last_meal_time(
+				&sim->philosophers[first + i]) + ms_to_ns(sim->time_to_die);
+	}
+	i = heap->size / 2;
+	while (--i >= 0)
+		deadline_heap_sift_down(heap, i);
+}
+
+/**
+ * @brief Replaces the deadline of the earliest entry and restores the heap.
+ * 
+ * Philosophers never touch the heap themselves: they only publish their
+ * meal time. When the monitor finds that the earliest entry is stale because
+ * that philosopher has eaten since, it calls this in O(log N).
+ * 
+ * @param heap The heap to update.
+ * @param deadline The new deadline of the top entry.
+ */
+void	deadline_heap_update_top(t_deadline_heap *heap, long long deadline)
+{
+	heap->entries[0].deadline = deadline;
+	deadline_heap_sift_down(heap, 0);
+}
@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   decode.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:57:39 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:01:38 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+#include <fcntl.h> // open()
+
+/**
+ * @brief Reads exactly `size` bytes unless the input ends first.
+ * 
+ * @param fd The input.
+ * @param buffer Receives the bytes.
+ * @param size Number of bytes to read.
+ * @return The number of bytes read: `size`, or fewer at the end of the
+ *         input or on a read error.
+ */
+static size_t	read_exact(int fd, unsigned char *buffer, size_t size)
+{
+	size_t	done;
+	ssize_t	result;
+
+	done = 0;
+	while (done < size)
+	{
+		result = read(fd, buffer + done, size - done);
+		if (result <= 0)
+			break ;
+		done += result;
+	}
+	return (done);
+}
+
+/**
+ * @brief Decodes the blocks of a `--trace=binary` trace.
+ * 
+ * A trace that ends part-way through a block is decoded up to the last
+ * complete block.
+ * 
+ * @param fd The trace, positioned after LOG_TRACE_MAGIC.
+ * @param logger A text logger with `start_time` 0.
+ * @param payload Scratch space for one block's payload.
+ * @return SUCCESS (=0), or FAILURE (=1) after printing an error.
+ */
+static int	decode_blocks(int fd, t_logger *logger, unsigned char *payload)
+{
+	unsigned char	header[LOG_BLOCK_HEADER];
+	size_t			size;
+
+	size = read_exact(fd, header, LOG_BLOCK_HEADER);
+	while (size == LOG_BLOCK_HEADER)
+	{
+		size = decode_load_le(header + 1, 4);
+		if (header[0] != LOG_BLOCK_TAG || size > LOG_BATCH_BYTES)
+			return (print_error("Error: Corrupt trace block.\n"));
+		if (read_exact(fd, payload, size) != size)
+			return (print_error("Error: Truncated trace.\n"));
+		if (decode_block(logger, header, payload) != SUCCESS)
+			return (print_error("Error: Corrupt trace block.\n"));
+		size = read_exact(fd, header, LOG_BLOCK_HEADER);
+	}
+	if (size != 0)
+		return (print_error("Error: Truncated trace.\n"));
+	return (SUCCESS);
+}
+
+/**
+ * @brief Decodes a whole trace of either kind, told apart by its magic.
+ * 
+ * An empty input is an empty trace.
+ * 
+ * @param fd The trace.
+ * @param logger A text logger with `start_time` 0.
+ * @param payload Scratch space for one block's payload.
+ * @return SUCCESS (=0), or FAILURE (=1) after printing an error.
+ */
+static int	decode_stream(int fd, t_logger *logger, unsigned char *payload)
+{
+	unsigned char	magic[LOG_TRACE_MAGIC_SIZE];
+	size_t			size;
+
+	size = read_exact(fd, magic, LOG_TRACE_MAGIC_SIZE);
+	if (size == 0)
+		return (SUCCESS);
+	if (size == LOG_TRACE_MAGIC_SIZE
+		&& memcmp(magic, LOG_FILE_MAGIC, LOG_TRACE_MAGIC_SIZE) == 0)
+		return (decode_slots(fd, logger));
+	if (size != LOG_TRACE_MAGIC_SIZE
+		|| memcmp(magic, LOG_TRACE_MAGIC, LOG_TRACE_MAGIC_SIZE) != 0)
+		return (print_error("Error: Not a philo trace.\n"));
+	return (decode_blocks(fd, logger, payload));
+}
+
+/**
+ * @brief philo-decode: converts a `--trace=binary` trace or a
+ *        `--trace-file` back into the text output of philo.
+ * 
+ * Usage: `philo-decode [TRACE]`; the trace is read from standard input if
+ * no file is given, and the text goes to standard output.
+ * 
+ * @param argc The number of command-line arguments.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return Returns SUCCESS if the whole trace was decoded, otherwise FAILURE.
+ */
+int	main(int argc, char *argv[])
+{
+	t_logger		logger;
+	unsigned char	*payload;
+	int				fd;
+	int				status;
+
+	if (argc > 2)
+		return (print_error("Usage: philo-decode [TRACE]\n"));
+	fd = 0;
+	if (argc == 2)
+		fd = open(argv[1], O_RDONLY);
+	if (fd < 0)
+		return (print_error("Error: Cannot open the trace.\n"));
+	memset(&logger, 0, sizeof(t_logger));
+	logger.buffer = malloc(LOG_BATCH_BYTES);
+	payload = malloc(LOG_BATCH_BYTES);
+	if (logger.buffer && payload)
+		status = decode_stream(fd, &logger, payload);
+	else
+		status = print_error("Error: Decoder allocation failed.\n");
+	log_flush(&logger);
+	free(logger.buffer);
+	free(payload);
+	if (fd > 0)
+		close(fd);
+	return (status);
+}
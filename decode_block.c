@@ -0,0 +1,92 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   decode_block.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:57:39 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:01:38 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Reads an unsigned LEB128 varint and advances past it.
+ * 
+ * @param at The read position; moved past the varint.
+ * @param end End of the payload.
+ * @param value Receives the value.
+ * @return SUCCESS (=0), or FAILURE (=1) if it runs past `end`.
+ */
+static int	read_varint(const unsigned char **at, const unsigned char *end,
+	unsigned long long *value)
+{
+	int	shift;
+
+	*value = 0;
+	shift = 0;
+	while (*at < end && shift < 64)
+	{
+		*value |= (unsigned long long)(**at & 0x7F) << shift;
+		shift += 7;
+		if (!(*(*at)++ & 0x80))
+			return (SUCCESS);
+	}
+	return (FAILURE);
+}
+
+/**
+ * @brief Loads a little-endian integer of `bytes` bytes.
+ * 
+ * @param in The bytes.
+ * @param bytes Width of the integer.
+ * @return Its value.
+ */
+unsigned long long	decode_load_le(const unsigned char *in, int bytes)
+{
+	unsigned long long	value;
+
+	value = 0;
+	while (bytes-- > 0)
+		value = value << 8 | in[bytes];
+	return (value);
+}
+
+/**
+ * @brief Turns one block's records back into text lines.
+ * 
+ * Each record goes through log_append_record() of a text logger, the very
+ * formatter of the live output, so the text is identical.
+ * 
+ * @param logger A text logger with `start_time` 0.
+ * @param header The block header (LOG_BLOCK_HEADER bytes).
+ * @param payload The block payload.
+ * @return SUCCESS (=0), or FAILURE (=1) if the payload is malformed.
+ */
+int	decode_block(t_logger *logger, const unsigned char *header,
+	const unsigned char *payload)
+{
+	const unsigned char	*end;
+	unsigned long long	value;
+	t_log_record		record;
+	long				count;
+
+	end = payload + decode_load_le(header + 1, 4);
+	count = (long)decode_load_le(header + 5, 4);
+	record.timestamp = (long long)decode_load_le(header + 9, 8);
+	while (count-- > 0)
+	{
+		if (read_varint(&payload, end, &value) != SUCCESS)
+			return (FAILURE);
+		record.timestamp += (long long)(value >> 1) ^ -(long long)(value & 1);
+		if (read_varint(&payload, end, &value) != SUCCESS || payload >= end
+			|| *payload >= LOG_EVENT_COUNT)
+			return (FAILURE);
+		record.philo_id = (int)value;
+		record.event = *payload++;
+		log_append_record(logger, &record);
+	}
+	return (payload != end);
+}
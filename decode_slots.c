@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   decode_slots.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 16:20:41 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/15 16:20:41 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Reads one committed slot of a `--trace-file`.
+ * 
+ * @param fd The trace file.
+ * @param record Receives the slot's event.
+ * @return TRUE (=1) if a committed slot was read, FALSE (=0) at the end of
+ *         the input or at the first slot that was never committed.
+ */
+static int	read_slot(int fd, t_log_record *record)
+{
+	unsigned char	slot[sizeof(t_log_slot)];
+
+	if (read(fd, slot, sizeof(t_log_slot)) != sizeof(t_log_slot)
+		|| slot[offsetof(t_log_slot, committed)] != LOG_SLOT_COMMITTED)
+		return (FALSE);
+	record->timestamp = (long long)decode_load_le(slot, 8);
+	record->philo_id = (int)decode_load_le(slot
+			+ offsetof(t_log_slot, philo_id), 4);
+	record->event = slot[offsetof(t_log_slot, event)];
+	return (TRUE);
+}
+
+/**
+ * @brief Reads every committed slot into one growing array.
+ * 
+ * @param fd The trace file, positioned after the header.
+ * @param records Receives the array, to be freed by the caller.
+ * @return The number of records, or -1 after printing an error.
+ */
+static long	read_slots(int fd, t_log_record **records)
+{
+	t_log_record	*grown;
+	long			count;
+	long			capacity;
+
+	count = 0;
+	capacity = 0;
+	while (TRUE)
+	{
+		if (count == capacity)
+		{
+			capacity = capacity * 2 + 1024;
+			grown = realloc(*records, capacity * sizeof(t_log_record));
+			if (!grown)
+			{
+				print_error("Error: Decoder allocation failed.\n");
+				return (-1);
+			}
+			*records = grown;
+		}
+		if (!read_slot(fd, &(*records)[count]))
+			return (count);
+		if ((*records)[count++].event >= LOG_EVENT_COUNT)
+		{
+			print_error("Error: Corrupt trace file slot.\n");
+			return (-1);
+		}
+	}
+}
+
+/**
+ * @brief Sorts the records by timestamp, keeping the slot order of equal
+ *        timestamps.
+ * 
+ * Slots are in reservation order, which is time order except for the
+ * events whose producer was preempted between reading the clock and
+ * reserving, so an insertion sort has little to move.
+ * 
+ * @param records The records, in slot order.
+ * @param count Number of records.
+ */
+static void	sort_records(t_log_record *records, long count)
+{
+	t_log_record	record;
+	long			i;
+	long			j;
+
+	i = 0;
+	while (++i < count)
+	{
+		record = records[i];
+		j = i;
+		while (j > 0 && records[j - 1].timestamp > record.timestamp)
+		{
+			records[j] = records[j - 1];
+			j--;
+		}
+		records[j] = record;
+	}
+}
+
+/**
+ * @brief Turns the slots of a `--trace-file` back into text lines, in
+ *        time order.
+ * 
+ * Slots are read up to the first one that was never committed, which is
+ * where a killed run's file ends. They are sorted by timestamp, since the
+ * file holds them in reservation order, and printed up to the death,
+ * after which a text run prints nothing either.
+ * 
+ * @param fd The trace file, positioned after LOG_FILE_MAGIC.
+ * @param logger A text logger with `start_time` 0.
+ * @return SUCCESS (=0), or FAILURE (=1) after printing an error.
+ */
+int	decode_slots(int fd, t_logger *logger)
+{
+	unsigned char	header[sizeof(t_log_slot)];
+	t_log_record	*records;
+	long			count;
+	long			i;
+
+	if (read(fd, header, sizeof(t_log_slot) - LOG_TRACE_MAGIC_SIZE)
+		!= sizeof(t_log_slot) - LOG_TRACE_MAGIC_SIZE
+		|| header[0] != sizeof(t_log_slot))
+		return (print_error("Error: Corrupt trace file header.\n"));
+	records = NULL;
+	count = read_slots(fd, &records);
+	sort_records(records, count);
+	i = -1;
+	while (++i < count && (i == 0 || records[i - 1].event != LOG_DIED))
+		log_append_record(logger, &records[i]);
+	free(records);
+	if (count < 0)
+		return (FAILURE);
+	return (SUCCESS);
+}
@@ -0,0 +1,175 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fork_chandy.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:15:41 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:31:58 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Handles a pending request for a fork on behalf of its owner.
+ * 
+ * This is the owner's message handler: once the request token has
+ * reached the owner, and the fork is dirty and its owner is not eating,
+ * the fork is cleaned and sent to the other philosopher, and the token
+ * stays behind. Whoever changes one of these conditions runs the handler
+ * under the fork's mutex, so the request is answered even while the
+ * owner's thread sleeps, thinks, or has already left the table.
+ * 
+ * @param chandy The strategy state.
+ * @param fork Index of the fork, whose mutex the caller holds.
+ * @param count Number of philosophers.
+ */
+static void	serve_request(t_chandy *chandy, int fork, int count)
+{
+	t_chandy_fork	*f;
+
+	f = &chandy->forks[fork];
+	if (f->request != f->owner || !f->dirty || chandy->eating[f->owner])
+		return ;
+	if (f->owner == fork)
+		f->owner = (fork + count - 1) % count;
+	else
+		f->owner = fork;
+	f->dirty = FALSE;
+	pthread_cond_broadcast(&f->cond);
+}
+
+/**
+ * @brief Waits until a philosopher owns a fork, asking for it first.
+ * 
+ * A philosopher who holds the fork's request token but not the fork
+ * sends the token to the owner; one who holds neither has asked already.
+ * The wait ends with the simulation too: chandy_cancel() wakes it.
+ * 
+ * @param philo The asking philosopher.
+ * @param fork Index of the fork.
+ * @return TRUE (=1) once the philosopher owns the fork, FALSE (=0) if the
+ *         simulation ended first.
+ */
+static int	obtain_fork(t_philosopher *philo, int fork)
+{
+	t_chandy		*chandy;
+	t_chandy_fork	*f;
+	int				self;
+	int				owned;
+
+	chandy = philo->simulation->strategy_data;
+	self = philo->left_fork_index;
+	f = &chandy->forks[fork];
+	pthread_mutex_lock(&f->mutex);
+	if (f->owner != self && f->request == self)
+	{
+		f->request = f->owner;
+		serve_request(chandy, fork, philo->simulation->philosopher_count);
+	}
+	while (f->owner != self && !is_simulation_finished(philo->simulation))
+		pthread_cond_wait(&f->cond, &f->mutex);
+	owned = (f->owner == self);
+	pthread_mutex_unlock(&f->mutex);
+	return (owned);
+}
+
+/**
+ * @brief Locks or unlocks the mutexes of a philosopher's two forks,
+ *        locking in index order so that two callers cannot deadlock.
+ * 
+ * @param philo The philosopher.
+ * @param lock TRUE to lock, FALSE to unlock.
+ */
+static void	lock_pair(t_philosopher *philo, int lock)
+{
+	t_chandy	*chandy;
+	int			low;
+	int			high;
+
+	chandy = philo->simulation->strategy_data;
+	low = philo->left_fork_index;
+	high = philo->right_fork_index;
+	if (low > high)
+	{
+		low = philo->right_fork_index;
+		high = philo->left_fork_index;
+	}
+	if (lock)
+	{
+		pthread_mutex_lock(&chandy->forks[low].mutex);
+		pthread_mutex_lock(&chandy->forks[high].mutex);
+		return ;
+	}
+	pthread_mutex_unlock(&chandy->forks[high].mutex);
+	pthread_mutex_unlock(&chandy->forks[low].mutex);
+}
+
+/**
+ * @brief Acquires both forks with the Chandy-Misra protocol.
+ * 
+ * The philosopher obtains each fork in turn. Then, holding both forks'
+ * mutexes, they check that they still own both and start eating, which
+ * makes both forks dirty. A fork the philosopher already owned from their
+ * last meal is still dirty. It goes to a neighbour who asks for it in
+ * the meantime; the check then fails and the forks are asked for again.
+ * A fork received clean is kept until it has been eaten with.
+ * 
+ * The end of the simulation cancels the wait. The philosopher keeps the
+ * forks they own, which is all the state a fork has, so nothing needs to
+ * be handed back.
+ * 
+ * @param philo The philosopher who is acquiring the forks.
+ * @return TRUE (=1) once the philosopher eats, FALSE (=0) if the end of
+ *         the simulation came first.
+ */
+int	chandy_acquire(t_philosopher *philo)
+{
+	t_chandy	*chandy;
+	long long	wait_start;
+	int			self;
+
+	chandy = philo->simulation->strategy_data;
+	self = philo->left_fork_index;
+	wait_start = 0;
+	if (PHILO_STATS)
+		wait_start = get_time_ns();
+	while (!chandy->eating[self])
+	{
+		if (!obtain_fork(philo, philo->left_fork_index)
+			|| !obtain_fork(philo, philo->right_fork_index))
+			return (FALSE);
+		lock_pair(philo, TRUE);
+		chandy->eating[self] = (chandy->forks[philo->left_fork_index].owner
+				== self && chandy->forks[philo->right_fork_index].owner
+				== self);
+		chandy->forks[philo->left_fork_index].dirty |= chandy->eating[self];
+		chandy->forks[philo->right_fork_index].dirty |= chandy->eating[self];
+		lock_pair(philo, FALSE);
+	}
+	announce_fork(philo, LOG_TAKEN_LEFT_FORK, wait_start);
+	announce_fork(philo, LOG_TAKEN_RIGHT_FORK, wait_start);
+	return (TRUE);
+}
+
+/**
+ * @brief Stops eating and answers the requests that arrived meanwhile;
+ *        a fork nobody asked for stays with the philosopher, dirty.
+ * 
+ * @param philo The philosopher who is releasing the forks.
+ */
+void	chandy_release(t_philosopher *philo)
+{
+	t_chandy	*chandy;
+	int			count;
+
+	chandy = philo->simulation->strategy_data;
+	count = philo->simulation->philosopher_count;
+	lock_pair(philo, TRUE);
+	chandy->eating[philo->left_fork_index] = FALSE;
+	serve_request(chandy, philo->left_fork_index, count);
+	serve_request(chandy, philo->right_fork_index, count);
+	lock_pair(philo, FALSE);
+}
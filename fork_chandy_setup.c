@@ -0,0 +1,124 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fork_chandy_setup.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:15:41 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:22:01 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Returns the arena bytes chandy_init() carves out.
+ * 
+ * @param sim A configured simulation.
+ * @return The size in bytes.
+ */
+size_t	chandy_size(t_simulation *sim)
+{
+	return (arena_span(sizeof(t_chandy))
+		+ arena_span(sizeof(t_chandy_fork) * sim->philosopher_count)
+		+ arena_span(sizeof(char) * sim->philosopher_count));
+}
+
+/**
+ * @brief Carves the Chandy-Misra forks out of the simulation's arena and
+ *        gives each to a philosopher.
+ * 
+ * Fork `f` is shared by philosophers `f - 1` and `f`; it starts dirty and
+ * owned by the lower-numbered one, and its request token starts with the
+ * other one. The precedence graph "holds a dirty fork wanted by" is then
+ * acyclic and no philosopher can wait forever.
+ * 
+ * @param sim The simulation, whose `strategy_data` receives the state.
+ * @return SUCCESS, or FAILURE if an allocation or initialization failed.
+ */
+int	chandy_init(t_simulation *sim)
+{
+	t_chandy	*chandy;
+	int			count;
+	int			f;
+
+	chandy = arena_alloc(&sim->arena, sizeof(t_chandy));
+	if (!chandy)
+		return (print_error("Error: Chandy-Misra allocation failed.\n"));
+	sim->strategy_data = chandy;
+	count = sim->philosopher_count;
+	chandy->forks = arena_alloc(&sim->arena, sizeof(t_chandy_fork) * count);
+	chandy->eating = arena_alloc(&sim->arena, sizeof(char) * count);
+	if (!chandy->forks || !chandy->eating)
+		return (print_error("Error: Chandy-Misra allocation failed.\n"));
+	f = -1;
+	while (++f < count)
+	{
+		chandy->forks[f].owner = (f + count - 1) % count;
+		chandy->forks[f].request = f;
+		if (f < chandy->forks[f].owner)
+		{
+			chandy->forks[f].request = chandy->forks[f].owner;
+			chandy->forks[f].owner = f;
+		}
+		chandy->forks[f].dirty = TRUE;
+		if (pthread_mutex_init(&chandy->forks[f].mutex, NULL) != SUCCESS)
+			return (print_error("Error: Chandy-Misra init failed.\n"));
+		if (pthread_cond_init(&chandy->forks[f].cond, NULL) != SUCCESS)
+		{
+			pthread_mutex_destroy(&chandy->forks[f].mutex);
+			return (print_error("Error: Chandy-Misra init failed.\n"));
+		}
+		chandy->ready = f + 1;
+	}
+	return (SUCCESS);
+}
+
+/**
+ * @brief Wakes every philosopher waiting for a Chandy-Misra fork, so
+ *        that they see the end of the simulation.
+ * 
+ * Called by end_simulation() after the end flag is set. Each broadcast
+ * happens under the fork's mutex, so a waiter either saw the flag before
+ * sleeping or is woken.
+ * 
+ * @param sim The simulation owning the state.
+ */
+void	chandy_cancel(t_simulation *sim)
+{
+	t_chandy	*chandy;
+	int			f;
+
+	chandy = sim->strategy_data;
+	f = -1;
+	while (++f < chandy->ready)
+	{
+		pthread_mutex_lock(&chandy->forks[f].mutex);
+		pthread_cond_broadcast(&chandy->forks[f].cond);
+		pthread_mutex_unlock(&chandy->forks[f].mutex);
+	}
+}
+
+/**
+ * @brief Destroys the forks set up by chandy_init().
+ * 
+ * After a failed chandy_init(), only the forks it initialized are
+ * destroyed. Their memory belongs to the arena.
+ * 
+ * @param sim The simulation owning the state.
+ */
+void	chandy_destroy(t_simulation *sim)
+{
+	t_chandy	*chandy;
+	int			f;
+
+	chandy = sim->strategy_data;
+	f = -1;
+	while (++f < chandy->ready)
+	{
+		pthread_mutex_destroy(&chandy->forks[f].mutex);
+		pthread_cond_destroy(&chandy->forks[f].cond);
+	}
+	sim->strategy_data = NULL;
+}
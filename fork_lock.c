@@ -0,0 +1,155 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fork_lock.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:22:41 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:31:58 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Initializes a free fork lock.
+ * 
+ * @param lock The lock to initialize.
+ */
+void	fork_lock_init(t_fork_lock *lock)
+{
+	atomic_init(&lock->next, 0);
+	atomic_init(&lock->serving, 0);
+	atomic_init(&lock->sleepers, 0);
+	atomic_init(&lock->spin, 0);
+	atomic_init(&lock->waits, 0);
+}
+
+/**
+ * @brief Spins until a ticket is served or the spin budget runs out.
+ * 
+ * The budget adapts like glibc's adaptive mutexes: each wait may spin up
+ * to twice the learned budget plus a little, and the budget then moves an
+ * eighth of the way towards what this wait actually needed, or towards
+ * zero if spinning did not pay off. A fork released within a few
+ * microseconds is taken without a system call, while on an oversubscribed
+ * machine, where the holder cannot run while we spin, spinning dies out.
+ * 
+ * @param lock The lock being waited for.
+ * @param ticket The caller's ticket.
+ * @return TRUE if the ticket is being served.
+ */
+static int	spin_for_turn(t_fork_lock *lock, int ticket)
+{
+	int	budget;
+	int	spins;
+	int	learned;
+
+	learned = atomic_load_explicit(&lock->spin, memory_order_relaxed);
+	budget = learned * 2 + 10;
+	if (budget > FORK_SPIN_MAX)
+		budget = FORK_SPIN_MAX;
+	spins = 0;
+	while (spins < budget && atomic_load_explicit(&lock->serving,
+			memory_order_acquire) != ticket)
+	{
+		cpu_relax();
+		spins++;
+	}
+	if (spins == budget)
+		spins = 0;
+	atomic_store_explicit(&lock->spin, learned + (spins - learned) / 8,
+		memory_order_relaxed);
+	return (atomic_load_explicit(&lock->serving, memory_order_acquire)
+		== ticket);
+}
+
+/**
+ * @brief Hands on a ticket whose wait was cancelled.
+ * 
+ * A ticket that is never served would block everyone queued behind it, so
+ * the caller still waits for its turn, now without cancellation, and
+ * releases the fork at once. After the end every holder puts their forks
+ * down without eating, so this only waits for a few hand-overs.
+ * 
+ * @param lock The fork's lock.
+ * @param ticket The caller's ticket.
+ */
+static void	pass_ticket(t_fork_lock *lock, int ticket)
+{
+	int	serving;
+
+	serving = atomic_load(&lock->serving);
+	while (serving != ticket)
+	{
+		futex_wait(&lock->serving, serving);
+		serving = atomic_load(&lock->serving);
+	}
+	atomic_fetch_sub_explicit(&lock->sleepers, 1, memory_order_relaxed);
+	fork_lock_release(lock);
+}
+
+/**
+ * @brief Takes a fork, in the order the requests were made.
+ * 
+ * The caller draws a ticket. If it is not served at once they spin for a
+ * while (spin_for_turn()), then announce themselves in `sleepers` and
+ * sleep on `serving`. The futex only blocks while `serving` still holds
+ * the value just read, so a release in between is never missed.
+ * 
+ * The sleep is cancellable: it also watches `cancel`, the simulation's
+ * end flag, so end_simulation()'s single broadcast wakes every fork waiter
+ * too, and they give up instead of waiting for a meal to end. A given-up
+ * ticket is handed on (pass_ticket()), so the queue behind it drains.
+ * 
+ * A ticket that is not served at once counts in `waits`, the `--metrics`
+ * counter of contended acquires.
+ * 
+ * @param lock The fork's lock.
+ * @param cancel The flag that ends the wait once set.
+ * @return TRUE (=1) if the fork is held, FALSE (=0) if the wait was
+ *         cancelled; the fork is not held then.
+ */
+int	fork_lock_acquire(t_fork_lock *lock, _Atomic int *cancel)
+{
+	int	ticket;
+	int	serving;
+
+	ticket = atomic_fetch_add_explicit(&lock->next, 1, memory_order_relaxed);
+	if (atomic_load_explicit(&lock->serving, memory_order_acquire) == ticket
+		|| spin_for_turn(lock, ticket))
+		return (TRUE);
+	atomic_fetch_add_explicit(&lock->waits, 1, memory_order_relaxed);
+	atomic_fetch_add(&lock->sleepers, 1);
+	serving = atomic_load(&lock->serving);
+	while (serving != ticket && !atomic_load(cancel))
+	{
+		futex_wait_cancellable(&lock->serving, serving, cancel);
+		serving = atomic_load(&lock->serving);
+	}
+	if (serving != ticket)
+	{
+		pass_ticket(lock, ticket);
+		return (FALSE);
+	}
+	atomic_fetch_sub_explicit(&lock->sleepers, 1, memory_order_relaxed);
+	return (TRUE);
+}
+
+/**
+ * @brief Hands a fork to the next ticket.
+ * 
+ * The futex is only woken if some waiter went to sleep: the sequentially
+ * consistent increment and load pair with the waiter's increment of
+ * `sleepers` and load of `serving`, so either the waiter sees the new
+ * ticket or the releaser sees the sleeper.
+ * 
+ * @param lock The fork's lock, held by the caller.
+ */
+void	fork_lock_release(t_fork_lock *lock)
+{
+	atomic_fetch_add(&lock->serving, 1);
+	if (atomic_load(&lock->sleepers) > 0)
+		futex_wake_all(&lock->serving);
+}
@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fork_ordered.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:14:49 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:31:58 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Acquires the forks in an order that depends on the parity of the id.
+ * 
+ * To prevent deadlock, neighbours take their shared fork at opposite ends
+ * of their acquisition:
+ * 
+ * 1. Odd-numbered philosophers: pick up the left fork first, then the right.
+ * 2. Even-numbered philosophers: pick up the right fork first, then the left.
+ * 
+ * @param philo The philosopher who is acquiring the forks.
+ * @return TRUE (=1) once both forks are held, FALSE (=0) if the end of the
+ *         simulation cancelled a wait; a fork already taken is put back.
+ */
+int	ordered_acquire(t_philosopher *philo)
+{
+	t_seat	*seats;
+	int		first;
+	int		second;
+
+	seats = philo->simulation->seats;
+	first = philo->right_fork_index;
+	second = philo->left_fork_index;
+	if (philo->id % 2 == 1)
+	{
+		first = philo->left_fork_index;
+		second = philo->right_fork_index;
+	}
+	if (!lock_fork(philo, first, fork_event(philo, first)))
+		return (FALSE);
+	if (lock_fork(philo, second, fork_event(philo, second)))
+		return (TRUE);
+	fork_lock_release(&seats[first].fork);
+	return (FALSE);
+}
+
+/**
+ * @brief Thinking delay of the ordered strategy.
+ * 
+ * With an odd number of philosophers the parity order leaves one pair of
+ * neighbours that both start on the same fork; the one who just ate waits
+ * 100 us so the other gets there first, which prevents livelock.
+ * 
+ * @param philo The philosopher who is thinking.
+ */
+void	ordered_think(t_philosopher *philo)
+{
+	if (philo->simulation->philosopher_count % 2 == 1)
+		usleep(100);
+}
+
+/**
+ * @brief Names the fork a philosopher took in the log.
+ * 
+ * @param philo The philosopher taking the fork.
+ * @param fork Index of the fork.
+ * @return LOG_TAKEN_LEFT_FORK or LOG_TAKEN_RIGHT_FORK on the ring, else
+ *         LOG_TAKEN_FORK.
+ */
+t_log_event	fork_event(t_philosopher *philo, int fork)
+{
+	if (philo->simulation->options.topology.kind != TOPOLOGY_RING)
+		return (LOG_TAKEN_FORK);
+	if (fork == philo->left_fork_index)
+		return (LOG_TAKEN_LEFT_FORK);
+	return (LOG_TAKEN_RIGHT_FORK);
+}
+
+/**
+ * @brief Acquires the lower-numbered fork first (resource hierarchy).
+ * 
+ * Forks are totally ordered by index and every philosopher takes them in
+ * that order, so no cycle of waiters can form. On the ring only the last
+ * philosopher, whose right fork is fork 0, starts on their right; the
+ * same order takes any number of forks on the other topologies, whose
+ * rows are sorted ascending.
+ * 
+ * @param philo The philosopher who is acquiring the forks.
+ * @return TRUE (=1) once every fork is held, FALSE (=0) if the end of the
+ *         simulation cancelled a wait; the forks already taken are put
+ *         back.
+ */
+int	hierarchy_acquire(t_philosopher *philo)
+{
+	int	i;
+
+	i = 0;
+	while (i < philo->fork_count)
+	{
+		if (!lock_fork(philo, philo->forks[i],
+				fork_event(philo, philo->forks[i])))
+		{
+			while (i-- > 0)
+				fork_lock_release(
+					&philo->simulation->seats[philo->forks[i]].fork);
+			return (FALSE);
+		}
+		i++;
+	}
+	return (TRUE);
+}
@@ -0,0 +1,166 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fork_schedule.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:21:31 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:31:58 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Returns the round a philosopher eats in after `turn`.
+ * 
+ * With color classes that is the class's next round. On a rotating odd
+ * ring of `N = 2k + 1`, round `r` seats `r, r + 2, ..., r + 2k - 2`, so
+ * `floor(N / 2)` philosophers eat in every round: each seat eats every
+ * other round, except that the seat `r` itself, the first of its round,
+ * waits three rounds once per cycle of N.
+ * 
+ * @param schedule The schedule.
+ * @param seat Index of the philosopher.
+ * @param turn A round the philosopher eats in.
+ * @return The philosopher's next round.
+ */
+static int	next_turn(t_schedule *schedule, int seat, int turn)
+{
+	if (!schedule->rotating)
+		return (turn + schedule->color_count);
+	if (seat == turn % schedule->count)
+		return (turn + 3);
+	return (turn + 2);
+}
+
+/**
+ * @brief Waits for the philosopher's round of the precomputed schedule.
+ * 
+ * No two philosophers who eat in the same round share a fork, so once the
+ * round's gate shows the philosopher's turn their forks are free: nothing
+ * is locked; they are announced at once. The wait is also cancelled by
+ * the end of the simulation, after which nobody opens the gates any more.
+ * 
+ * @param philo The philosopher who is acquiring the forks.
+ * @return TRUE (=1) in the philosopher's round, FALSE (=0) if the end of
+ *         the simulation came first.
+ */
+int	schedule_acquire(t_philosopher *philo)
+{
+	t_simulation	*sim;
+	t_schedule		*schedule;
+	long long		wait_start;
+	int				turn;
+	int				seen;
+	int				i;
+
+	sim = philo->simulation;
+	schedule = sim->strategy_data;
+	turn = schedule->turns[philo->id - 1];
+	wait_start = 0;
+	if (PHILO_STATS)
+		wait_start = get_time_ns();
+	seen = atomic_load_explicit(&schedule->gates[turn
+			% schedule->gate_count], memory_order_acquire);
+	while (seen != turn && !is_simulation_finished(sim))
+	{
+		futex_wait_cancellable(&schedule->gates[turn
+			% schedule->gate_count], seen, &sim->simulation_ended);
+		seen = atomic_load_explicit(&schedule->gates[turn
+				% schedule->gate_count], memory_order_acquire);
+	}
+	if (seen != turn)
+		return (FALSE);
+	i = -1;
+	while (++i < philo->fork_count)
+		announce_fork(philo, fork_event(philo, philo->forks[i]), wait_start);
+	return (TRUE);
+}
+
+/**
+ * @brief Opens the first round after `turn` that somebody still at the
+ *        table has a turn in.
+ * 
+ * Everyone has finished the rounds up to `turn` and written their next
+ * turn before counting down `remaining`, so the eaters of the next round
+ * are counted by scanning `turns`, once per round. Their number is stored
+ * before the gate is opened with a release store, so each of them counts
+ * down from it. The caller holds `open_mutex`, so no one leaves in between.
+ * 
+ * @param schedule The schedule.
+ * @param turn The round that just ended.
+ */
+static void	open_next_gate(t_schedule *schedule, int turn)
+{
+	int	next;
+	int	eaters;
+	int	i;
+
+	next = turn;
+	eaters = 0;
+	while (eaters == 0 && ++next - turn <= schedule->gate_count)
+	{
+		i = -1;
+		while (++i < schedule->count)
+			eaters += (schedule->turns[i] == next && !schedule->left[i]);
+	}
+	if (eaters == 0)
+		return ;
+	atomic_store_explicit(&schedule->remaining, eaters, memory_order_relaxed);
+	atomic_store_explicit(&schedule->gates[next % schedule->gate_count],
+		next, memory_order_release);
+	futex_wake_all(&schedule->gates[next % schedule->gate_count]);
+}
+
+/**
+ * @brief Ends the philosopher's round, and opens the next round if they
+ *        were the last of its eaters to finish.
+ * 
+ * Counting down is lock-free; only the last eater takes `open_mutex`.
+ * 
+ * @param philo The philosopher who is releasing the forks.
+ */
+void	schedule_release(t_philosopher *philo)
+{
+	t_schedule	*schedule;
+	int			turn;
+
+	schedule = philo->simulation->strategy_data;
+	turn = schedule->turns[philo->id - 1];
+	schedule->turns[philo->id - 1] = next_turn(schedule, philo->id - 1,
+			turn);
+	if (atomic_fetch_sub_explicit(&schedule->remaining, 1,
+			memory_order_acq_rel) != 1)
+		return ;
+	pthread_mutex_lock(&schedule->open_mutex);
+	open_next_gate(schedule, turn);
+	pthread_mutex_unlock(&schedule->open_mutex);
+}
+
+/**
+ * @brief Takes a philosopher who left the table out of the schedule.
+ * 
+ * Later rounds no longer wait for them. If their round is already open,
+ * they count as done with it, and open the next round if everybody else
+ * was.
+ * 
+ * @param philo The philosopher who left, no longer acquiring forks.
+ */
+void	schedule_leave(t_philosopher *philo)
+{
+	t_schedule	*schedule;
+	int			turn;
+
+	schedule = philo->simulation->strategy_data;
+	turn = schedule->turns[philo->id - 1];
+	pthread_mutex_lock(&schedule->open_mutex);
+	schedule->left[philo->id - 1] = TRUE;
+	if (atomic_load_explicit(&schedule->gates[turn % schedule->gate_count],
+			memory_order_acquire) == turn
+		&& atomic_fetch_sub_explicit(&schedule->remaining, 1,
+			memory_order_acq_rel) == 1)
+		open_next_gate(schedule, turn);
+	pthread_mutex_unlock(&schedule->open_mutex);
+}
@@ -0,0 +1,170 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fork_schedule_setup.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:21:31 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:23:54 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Gives a philosopher the lowest color no earlier philosopher who
+ *        shares one of their forks has.
+ * 
+ * @param philo The philosopher to color.
+ * @param used Per fork, a bit mask of the colors of its philosophers.
+ * @return The color, or -1 if all SCHEDULE_MAX_COLORS are taken.
+ */
+static int	pick_color(t_philosopher *philo, unsigned long long *used)
+{
+	unsigned long long	taken;
+	int					color;
+	int					i;
+
+	taken = 0;
+	i = -1;
+	while (++i < philo->fork_count)
+		taken |= used[philo->forks[i]];
+	color = 0;
+	while (color < SCHEDULE_MAX_COLORS && (taken >> color) & 1)
+		color++;
+	if (color == SCHEDULE_MAX_COLORS)
+		return (-1);
+	i = -1;
+	while (++i < philo->fork_count)
+		used[philo->forks[i]] |= 1ULL << color;
+	return (color);
+}
+
+/**
+ * @brief Colors the philosophers greedily, in index order, so that no two
+ *        philosophers of one color share a fork.
+ * 
+ * On the ring this gives the even count two alternating classes. An odd
+ * ring would get a third class holding only the last philosopher, so that
+ * every third round seats one eater; it rotates instead, with rounds 0, 1
+ * and 2 first seating the even seats but the last, the odd seats, and the
+ * last seat with the even ones that follow it. Rotating seats eat every
+ * other round, so it is only done while a philosopher sleeps no longer
+ * than a round: a longer sleep would stretch every round, and the seat
+ * that waits three rounds would then wait longer than a colored cycle.
+ * 
+ * @param sim The simulation, with its topology laid out.
+ * @param schedule Receives each philosopher's first turn and the number of
+ *                 colors.
+ * @return SUCCESS, or FAILURE after printing an error.
+ */
+static int	schedule_color(t_simulation *sim, t_schedule *schedule)
+{
+	unsigned long long	*used;
+	int					color;
+	int					i;
+
+	i = -1;
+	if (schedule->rotating)
+	{
+		while (++i < sim->philosopher_count)
+			schedule->turns[i] = i % 2 + 2 * (i == sim->philosopher_count - 1);
+		return (SUCCESS);
+	}
+	used = calloc(sim->seat_count, sizeof(unsigned long long));
+	if (!used)
+		return (print_error("Error: Schedule allocation failed.\n"));
+	while (++i < sim->philosopher_count)
+	{
+		color = pick_color(&sim->philosophers[i], used);
+		if (color < 0)
+		{
+			free(used);
+			return (print_error("Error: The topology needs too many "
+					"colors to schedule.\n"));
+		}
+		schedule->turns[i] = color;
+		if (color >= schedule->color_count)
+			schedule->color_count = color + 1;
+	}
+	free(used);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Returns the arena bytes schedule_init() carves out.
+ * 
+ * @param sim A configured simulation.
+ * @return The size in bytes.
+ */
+size_t	schedule_size(t_simulation *sim)
+{
+	return (arena_span(sizeof(t_schedule))
+		+ arena_span(sizeof(int) * sim->philosopher_count)
+		+ arena_span(sizeof(char) * sim->philosopher_count));
+}
+
+/**
+ * @brief Carves the schedule out of the simulation's arena and opens the
+ *        gate of the first round.
+ * 
+ * Every other gate starts one whole cycle behind the round it opens first,
+ * so it stays shut until the rounds before it have eaten.
+ * 
+ * @param sim The simulation, whose `strategy_data` receives the schedule.
+ * @return SUCCESS, or FAILURE if the allocation or the coloring failed.
+ */
+int	schedule_init(t_simulation *sim)
+{
+	t_schedule	*schedule;
+	int			eaters;
+	int			i;
+
+	schedule = arena_alloc(&sim->arena, sizeof(t_schedule));
+	if (!schedule)
+		return (print_error("Error: Schedule allocation failed.\n"));
+	sim->strategy_data = schedule;
+	schedule->count = sim->philosopher_count;
+	schedule->rotating = (sim->options.topology.kind == TOPOLOGY_RING
+			&& schedule->count % 2 == 1 && schedule->count >= 5
+			&& sim->time_to_sleep <= sim->time_to_eat);
+	schedule->turns = arena_alloc(&sim->arena, sizeof(int) * schedule->count);
+	schedule->left = arena_alloc(&sim->arena, sizeof(char) * schedule->count);
+	if (!schedule->turns || !schedule->left)
+		return (print_error("Error: Schedule allocation failed.\n"));
+	if (pthread_mutex_init(&schedule->open_mutex, NULL) != SUCCESS)
+		return (print_error("Error: Schedule initialization failed.\n"));
+	schedule->mutex_ready = TRUE;
+	if (schedule_color(sim, schedule) != SUCCESS)
+		return (FAILURE);
+	schedule->gate_count = schedule->color_count;
+	if (schedule->rotating)
+		schedule->gate_count = 4;
+	i = 0;
+	while (++i < schedule->gate_count)
+		atomic_init(&schedule->gates[i], i - schedule->gate_count);
+	atomic_init(&schedule->gates[0], 0);
+	eaters = 0;
+	i = -1;
+	while (++i < schedule->count)
+		eaters += (schedule->turns[i] == 0);
+	atomic_init(&schedule->remaining, eaters);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Destroys the mutex of the schedule set up by schedule_init(),
+ *        whose memory belongs to the arena.
+ * 
+ * @param sim The simulation owning the schedule.
+ */
+void	schedule_destroy(t_simulation *sim)
+{
+	t_schedule	*schedule;
+
+	schedule = sim->strategy_data;
+	if (schedule->mutex_ready)
+		pthread_mutex_destroy(&schedule->open_mutex);
+	sim->strategy_data = NULL;
+}
@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fork_strategy.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:15:52 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:23:54 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Returns the table of fork strategies, ending with a NULL name.
+ * 
+ * 1. ordered (the default): mutex forks taken in an order set by the id's
+ *    parity, with a short thinking delay for odd counts under
+ *    `--think=fixed`.
+ * 2. hierarchy: mutex forks taken lowest index first, the only strategy
+ *    that takes any number of forks, so it runs every `--topology`.
+ * 3. waiter: one arbitrator grants both forks at once, oldest ticket first.
+ * 4. chandy-misra: forks and request tokens passed between neighbours;
+ *    a dirty fork goes to whoever asks for it, a clean one is kept until
+ *    its owner has eaten.
+ * 5. priority: like waiter, but closest to death first instead of oldest.
+ * 6. schedule: a precomputed coloring; the classes eat in rounds and no
+ *    fork is ever contended or locked. An odd ring of five or more with
+ *    `time_to_sleep <= time_to_eat` rotates its rounds instead, so each
+ *    seats `floor(N / 2)` eaters and a philosopher eats every other round,
+ *    every third once per N rounds. A gate waits for eaters who are still
+ *    asleep, so with `time_to_sleep > (colors - 1) * time_to_eat` a cycle
+ *    takes `time_to_eat + time_to_sleep` instead of `colors * time_to_eat`:
+ *    `4 410 100 300` eats every 400 ms, 10 ms short of death.
+ * 
+ * @return A pointer to the first entry of the static table.
+ */
+static const t_fork_strategy	*strategy_table(void)
+{
+	static const t_fork_strategy	table[] = {
+	{"ordered", NULL, NULL, NULL, ordered_acquire, unlock_forks,
+		ordered_think, NULL, NULL, FALSE},
+	{"hierarchy", NULL, NULL, NULL, hierarchy_acquire, unlock_forks, NULL,
+		NULL, NULL, TRUE},
+	{"waiter", waiter_init, waiter_size, waiter_destroy, waiter_acquire,
+		waiter_release, NULL, NULL, waiter_cancel, FALSE},
+	{"chandy-misra", chandy_init, chandy_size, chandy_destroy,
+		chandy_acquire, chandy_release, NULL, NULL, chandy_cancel, FALSE},
+	{"priority", priority_init, waiter_size, waiter_destroy, waiter_acquire,
+		waiter_release, NULL, NULL, waiter_cancel, FALSE},
+	{"schedule", schedule_init, schedule_size, schedule_destroy,
+		schedule_acquire, schedule_release, NULL, schedule_leave, NULL, TRUE},
+	{NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, FALSE}
+	};
+
+	return (table);
+}
+
+/**
+ * @brief Looks a fork strategy up by name.
+ * 
+ * @param name The value of `--strategy=`.
+ * @return Index of the strategy, or -1 if there is none by that name.
+ */
+int	fork_strategy_find(const char *name)
+{
+	const t_fork_strategy	*table;
+	int						i;
+
+	table = strategy_table();
+	i = 0;
+	while (table[i].name)
+	{
+		if (strcmp(table[i].name, name) == 0)
+			return (i);
+		i++;
+	}
+	return (-1);
+}
+
+/**
+ * @brief Selects the strategy chosen in the options and sets up its state.
+ * 
+ * Other topologies than the ring default to the hierarchy strategy, and
+ * reject an explicit `--strategy` that only works on the ring.
+ * 
+ * @param sim The simulation; `options.fork_strategy` must be valid.
+ * @return SUCCESS, or FAILURE if the strategy's state could not be set up.
+ */
+int	fork_strategy_init(t_simulation *sim)
+{
+	int	ring;
+
+	ring = (sim->options.topology.kind == TOPOLOGY_RING);
+	if (!ring && !sim->options.strategy_set)
+		sim->options.fork_strategy = fork_strategy_find("hierarchy");
+	sim->strategy = &strategy_table()[sim->options.fork_strategy];
+	sim->strategy_data = NULL;
+	if (!ring && !sim->strategy->any_topology)
+		return (print_error("Error: This --strategy needs the ring "
+				"topology.\n"));
+	if (sim->strategy->init)
+		return (sim->strategy->init(sim));
+	return (SUCCESS);
+}
+
+/**
+ * @brief Releases the state of the selected strategy, if any was set up.
+ * 
+ * @param sim The simulation.
+ */
+void	fork_strategy_destroy(t_simulation *sim)
+{
+	if (sim->strategy && sim->strategy->destroy && sim->strategy_data)
+		sim->strategy->destroy(sim);
+	sim->strategy = NULL;
+}
+
+/**
+ * @brief Returns the arena bytes the `--strategy` will carve out, for
+ *        simulation_arena_init() to map before fork_strategy_init() runs.
+ * 
+ * Other topologies than the ring default to the stateless hierarchy
+ * strategy, as in fork_strategy_init().
+ * 
+ * @param sim A configured simulation.
+ * @return The size in bytes, 0 for a strategy without state.
+ */
+size_t	fork_strategy_size(t_simulation *sim)
+{
+	const t_fork_strategy	*strategy;
+
+	strategy = &strategy_table()[sim->options.fork_strategy];
+	if ((sim->options.topology.kind != TOPOLOGY_RING
+			&& !sim->options.strategy_set) || !strategy->size)
+		return (0);
+	return (strategy->size(sim));
+}
@@ -0,0 +1,129 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fork_waiter.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:15:24 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:31:58 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Draws a hungry philosopher's ticket. Called with the mutex held.
+ * 
+ * @param waiter The waiter state.
+ * @param philo The hungry philosopher.
+ * @return The next ticket, or with `--strategy=priority` the philosopher's
+ *         death deadline; smaller tickets have precedence.
+ */
+static long	draw_ticket(t_waiter *waiter, t_philosopher *philo)
+{
+	if (waiter->by_deadline)
+		return (atomic_load_explicit(&philo->seat->last_meal_time,
+				memory_order_relaxed)
+			+ ms_to_ns(philo->simulation->time_to_die));
+	return (++waiter->next_ticket);
+}
+
+/**
+ * @brief Wakes the philosophers whose precedence ran through a ticket that
+ *        was just withdrawn: the run of ever younger tickets on one side.
+ * 
+ * @param waiter The waiter state.
+ * @param philo The philosopher whose ticket was withdrawn.
+ * @param ticket The withdrawn ticket.
+ * @param step 1 to walk right, `philosopher_count - 1` to walk left.
+ */
+static void	wake_younger(t_waiter *waiter, t_philosopher *philo, long ticket,
+		int step)
+{
+	int	count;
+	int	seat;
+	int	next;
+
+	count = philo->simulation->philosopher_count;
+	seat = philo->left_fork_index;
+	next = (seat + step) % count;
+	while (waiter->tickets[next]
+		&& waiter_precedes(ticket, seat, waiter->tickets[next], next))
+	{
+		pthread_cond_signal(&waiter->turns[next]);
+		ticket = waiter->tickets[next];
+		seat = next;
+		next = (seat + step) % count;
+	}
+}
+
+/**
+ * @brief Asks the waiter for both forks and waits for permission.
+ * 
+ * The philosopher draws a ticket, or uses their death deadline as one
+ * with `--strategy=priority`, and sleeps on their own condition
+ * variable until waiter_can_eat() holds, then takes both forks at once and
+ * withdraws the ticket, which may change who has precedence further away.
+ * The end of the simulation, which waiter_cancel() broadcasts, also ends
+ * the wait; the ticket is then withdrawn without taking the forks.
+ * 
+ * @param philo The philosopher who is acquiring the forks.
+ * @return TRUE (=1) once both forks are taken, FALSE (=0) if the end of
+ *         the simulation came first.
+ */
+int	waiter_acquire(t_philosopher *philo)
+{
+	t_waiter	*waiter;
+	long long	wait_start;
+	long		ticket;
+	int			ticket_taken;
+	int			i;
+
+	waiter = philo->simulation->strategy_data;
+	i = philo->left_fork_index;
+	wait_start = 0;
+	if (PHILO_STATS)
+		wait_start = get_time_ns();
+	pthread_mutex_lock(&waiter->mutex);
+	ticket = draw_ticket(waiter, philo);
+	waiter->tickets[i] = ticket;
+	while (!waiter_can_eat(waiter, philo)
+		&& !is_simulation_finished(philo->simulation))
+		pthread_cond_wait(&waiter->turns[i], &waiter->mutex);
+	waiter->tickets[i] = 0;
+	ticket_taken = waiter_can_eat(waiter, philo);
+	waiter->fork_busy[philo->left_fork_index] = ticket_taken;
+	waiter->fork_busy[philo->right_fork_index] = ticket_taken;
+	wake_younger(waiter, philo, ticket,
+		philo->simulation->philosopher_count - 1);
+	wake_younger(waiter, philo, ticket, 1);
+	pthread_mutex_unlock(&waiter->mutex);
+	if (!ticket_taken)
+		return (FALSE);
+	announce_fork(philo, LOG_TAKEN_LEFT_FORK, wait_start);
+	announce_fork(philo, LOG_TAKEN_RIGHT_FORK, wait_start);
+	return (TRUE);
+}
+
+/**
+ * @brief Hands both forks back to the waiter and wakes both neighbours,
+ *        the only philosophers who can have been waiting for them.
+ * 
+ * @param philo The philosopher who is releasing the forks.
+ */
+void	waiter_release(t_philosopher *philo)
+{
+	t_waiter	*waiter;
+	int			count;
+
+	waiter = philo->simulation->strategy_data;
+	count = philo->simulation->philosopher_count;
+	pthread_mutex_lock(&waiter->mutex);
+	waiter->fork_busy[philo->left_fork_index] = FALSE;
+	waiter->fork_busy[philo->right_fork_index] = FALSE;
+	pthread_cond_signal(&waiter->turns[(philo->left_fork_index + count - 1)
+		% count]);
+	pthread_cond_signal(&waiter->turns[philo->right_fork_index]);
+	pthread_mutex_unlock(&waiter->mutex);
+}
@@ -0,0 +1,94 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fork_waiter_precedence.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:30:59 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:35:36 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Tells whether one hungry philosopher has precedence over another.
+ * 
+ * The smaller ticket wins. Death deadlines can tie, typically for the
+ * first meal; even seats then go before odd ones, so tied neighbours
+ * alternate, and lower seats before higher ones.
+ * 
+ * @param ticket_a Ticket of the first philosopher.
+ * @param seat_a Seat of the first philosopher.
+ * @param ticket_b Ticket of the second philosopher.
+ * @param seat_b Seat of the second philosopher.
+ * @return TRUE if the first philosopher goes first.
+ */
+int	waiter_precedes(long ticket_a, int seat_a, long ticket_b, int seat_b)
+{
+	if (ticket_a != ticket_b)
+		return (ticket_a < ticket_b);
+	if (seat_a % 2 != seat_b % 2)
+		return (seat_a % 2 == 0);
+	return (seat_a < seat_b);
+}
+
+/**
+ * @brief Counts the neighbours in one direction that are hungry with ever
+ *        older tickets (see waiter_precedes()), starting next to a hungry
+ *        philosopher.
+ * 
+ * The philosopher at the end of such a run waits for nobody on that side,
+ * the one before waits for them, the one before that does not, and so on:
+ * a philosopher gives way to an older neighbour only if that neighbour is
+ * not giving way themselves. The oldest ticket always has precedence, so
+ * nobody starves, and a row of hungry philosophers eats alternately
+ * instead of one after the other.
+ * 
+ * @param waiter The waiter state.
+ * @param seat Index of the hungry philosopher.
+ * @param step 1 to walk right, `philosopher_count - 1` to walk left.
+ * @param count The number of philosophers.
+ * @return Length of the run; odd if the philosopher must give way.
+ */
+static int	older_run(t_waiter *waiter, int seat, int step, int count)
+{
+	int	length;
+	int	next;
+
+	length = 0;
+	next = (seat + step) % count;
+	while (waiter->tickets[next] && waiter_precedes(waiter->tickets[next],
+			next, waiter->tickets[seat], seat))
+	{
+		length++;
+		seat = next;
+		next = (seat + step) % count;
+	}
+	return (length);
+}
+
+/**
+ * @brief Tells whether a hungry philosopher may start eating.
+ * 
+ * Both forks must be free and neither neighbour may have precedence (see
+ * older_run()). Called with the mutex held.
+ * 
+ * @param waiter The waiter state.
+ * @param philo The hungry philosopher.
+ * @return TRUE if the philosopher may take both forks now.
+ */
+int	waiter_can_eat(t_waiter *waiter, t_philosopher *philo)
+{
+	int	count;
+	int	seat;
+
+	count = philo->simulation->philosopher_count;
+	seat = philo->left_fork_index;
+	if (waiter->fork_busy[philo->left_fork_index]
+		|| waiter->fork_busy[philo->right_fork_index])
+		return (FALSE);
+	return (older_run(waiter, seat, count - 1, count) % 2 == 0
+		&& older_run(waiter, seat, 1, count) % 2 == 0);
+}
@@ -0,0 +1,131 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fork_waiter_setup.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:17:56 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:35:36 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Returns the arena bytes waiter_init() carves out.
+ * 
+ * @param sim A configured simulation.
+ * @return The size in bytes.
+ */
+size_t	waiter_size(t_simulation *sim)
+{
+	size_t	count;
+
+	count = sim->philosopher_count;
+	return (arena_span(sizeof(t_waiter)) + arena_span(sizeof(long) * count)
+		+ arena_span(sizeof(char) * count)
+		+ arena_span(sizeof(pthread_cond_t) * count));
+}
+
+/**
+ * @brief Carves the waiter out of the simulation's arena: per-philosopher
+ *        tickets and condition variables and per-fork busy flags.
+ * 
+ * @param sim The simulation, whose `strategy_data` receives the waiter.
+ * @return SUCCESS, or FAILURE if an allocation or initialization failed.
+ */
+int	waiter_init(t_simulation *sim)
+{
+	t_waiter	*waiter;
+	int			i;
+
+	waiter = arena_alloc(&sim->arena, sizeof(t_waiter));
+	if (!waiter)
+		return (print_error("Error: Waiter allocation failed.\n"));
+	sim->strategy_data = waiter;
+	waiter->tickets = arena_alloc(&sim->arena,
+			sizeof(long) * sim->philosopher_count);
+	waiter->fork_busy = arena_alloc(&sim->arena,
+			sizeof(char) * sim->philosopher_count);
+	waiter->turns = arena_alloc(&sim->arena,
+			sizeof(pthread_cond_t) * sim->philosopher_count);
+	if (!waiter->tickets || !waiter->fork_busy || !waiter->turns)
+		return (print_error("Error: Waiter allocation failed.\n"));
+	if (pthread_mutex_init(&waiter->mutex, NULL) != SUCCESS)
+		return (print_error("Error: Waiter initialization failed.\n"));
+	waiter->mutex_ready = TRUE;
+	i = -1;
+	while (++i < sim->philosopher_count)
+	{
+		if (pthread_cond_init(&waiter->turns[i], NULL) != SUCCESS)
+			return (print_error("Error: Waiter initialization failed.\n"));
+		waiter->turns_ready = i + 1;
+	}
+	return (SUCCESS);
+}
+
+/**
+ * @brief Allocates a waiter that serves the hungriest philosopher first.
+ * 
+ * Tickets are death deadlines, `last_meal_time + time_to_die`, so of two
+ * hungry neighbours the one with less time left has precedence and the
+ * other defers; otherwise it behaves exactly like waiter_init()'s waiter.
+ * 
+ * @param sim The simulation, whose `strategy_data` receives the waiter.
+ * @return SUCCESS, or FAILURE if an allocation or initialization failed.
+ */
+int	priority_init(t_simulation *sim)
+{
+	if (waiter_init(sim) != SUCCESS)
+		return (FAILURE);
+	((t_waiter *)sim->strategy_data)->by_deadline = TRUE;
+	return (SUCCESS);
+}
+
+/**
+ * @brief Wakes every philosopher waiting for the waiter, so that they see
+ *        the end of the simulation.
+ * 
+ * Called by end_simulation() after the end flag is set; the broadcast
+ * happens under the waiter's mutex, so no waiter misses it.
+ * 
+ * @param sim The simulation owning the waiter.
+ */
+void	waiter_cancel(t_simulation *sim)
+{
+	t_waiter	*waiter;
+	int			i;
+
+	waiter = sim->strategy_data;
+	if (!waiter->mutex_ready)
+		return ;
+	pthread_mutex_lock(&waiter->mutex);
+	i = -1;
+	while (++i < waiter->turns_ready)
+		pthread_cond_broadcast(&waiter->turns[i]);
+	pthread_mutex_unlock(&waiter->mutex);
+}
+
+/**
+ * @brief Destroys the mutex and condition variables of the waiter set up
+ *        by waiter_init() or priority_init().
+ * 
+ * After a failed initialization, only those that were initialized are
+ * destroyed. Their memory belongs to the arena.
+ * 
+ * @param sim The simulation owning the waiter.
+ */
+void	waiter_destroy(t_simulation *sim)
+{
+	t_waiter	*waiter;
+	int			i;
+
+	waiter = sim->strategy_data;
+	i = -1;
+	while (++i < waiter->turns_ready)
+		pthread_cond_destroy(&waiter->turns[i]);
+	if (waiter->mutex_ready)
+		pthread_mutex_destroy(&waiter->mutex);
+	sim->strategy_data = NULL;
+}
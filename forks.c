@@ -0,0 +1,117 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   forks.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:47:25 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:31:58 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Announces that a philosopher now holds a fork.
+ * 
+ * PHILO_STATS builds record how long the philosopher waited for the fork,
+ * separately for the left and the right fork, up to the timestamp of the
+ * announcement, so no extra clock reading is needed. Other builds skip a
+ * muted pickup (`--output=state`) without reading the clock at all.
+ * 
+ * @param philo The philosopher holding the fork.
+ * @param event LOG_TAKEN_LEFT_FORK or LOG_TAKEN_RIGHT_FORK.
+ * @param wait_start When the wait started, only read by PHILO_STATS builds.
+ */
+void	announce_fork(t_philosopher *philo, t_log_event event,
+			long long wait_start)
+{
+	long long	now;
+
+	if (!PHILO_STATS && is_event_muted(philo->simulation, event))
+		return ;
+	now = print_timestamp_and_philo_status_msg(philo, event);
+	if (PHILO_STATS)
+		stats_record_fork_wait(philo->stats, event, now - wait_start);
+}
+
+/**
+ * @brief Takes one fork's FIFO lock and announces it.
+ * 
+ * @param philo The philosopher taking the fork.
+ * @param fork_index Index of the fork (seat) to lock.
+ * @param event LOG_TAKEN_LEFT_FORK, LOG_TAKEN_RIGHT_FORK, or LOG_TAKEN_FORK
+ *        for a fork that is neither.
+ * @return TRUE (=1) if the fork is held, FALSE (=0) if the simulation
+ *         ended first.
+ */
+int	lock_fork(t_philosopher *philo, int fork_index, t_log_event event)
+{
+	long long	wait_start;
+
+	wait_start = 0;
+	if (PHILO_STATS)
+		wait_start = get_time_ns();
+	if (!fork_lock_acquire(&philo->simulation->seats[fork_index].fork,
+			&philo->simulation->simulation_ended))
+		return (FALSE);
+	announce_fork(philo, event, wait_start);
+	return (TRUE);
+}
+
+/**
+ * @brief Releases every fork lock taken with lock_fork(), handing each fork
+ *        to the neighbour waiting for it, if any.
+ * 
+ * @param philo The philosopher putting the forks down.
+ */
+void	unlock_forks(t_philosopher *philo)
+{
+	t_simulation	*sim;
+	int				i;
+
+	sim = philo->simulation;
+	i = 0;
+	while (i < philo->fork_count)
+		fork_lock_release(&sim->seats[philo->forks[i++]].fork);
+}
+
+/**
+ * @brief Makes a philosopher acquire their left and right forks.
+ * 
+ * How the forks are taken, and how deadlock is avoided, is up to the
+ * simulation's fork strategy (see fork_strategy.c).
+ * 
+ * PHILO_STATS builds also record how long it took to hold both forks.
+ * 
+ * @param philo The philosopher who is acquiring the forks.
+ * @return TRUE (=1) once the forks are held, FALSE (=0) if the end of the
+ *         simulation cancelled the wait; no fork is held then.
+ */
+int	acquire_forks(t_philosopher *philo)
+{
+	long long	wait_start;
+
+	wait_start = 0;
+	if (PHILO_STATS)
+		wait_start = get_time_ns();
+	if (!philo->simulation->strategy->acquire(philo))
+		return (FALSE);
+	if (PHILO_STATS)
+		histogram_record(&philo->stats->fork_wait, get_time_ns() - wait_start);
+	return (TRUE);
+}
+
+/**
+ * @brief Makes a philosopher release their left and right forks.
+ * 
+ * After a philosopher has finished eating, the simulation's fork strategy
+ * makes both forks available for other philosophers to use.
+ * 
+ * @param philo The philosopher who is releasing the forks.
+ */
+void	release_forks(t_philosopher *philo)
+{
+	philo->simulation->strategy->release(philo);
+}
@@ -6,118 +6,80 @@
 /*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/07/04 19:31:27 by hoskim            #+#    #+#             */
-/*   Updated: 2025/07/16 00:10:59 by hoskim           ###   ########seoul.kr  */
+/*   Updated: 2026/10/14 19:29:20 by hoskim           ###   ########seoul.kr  */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
 /**
- * @brief Checks if any philosopher has died from sarvation.
+ * @brief Waits for every thread of the simulation to finish.
  * 
- * This function iterates through all philosophers and calculates
- * the time elapsed since their last meal. If this time exceeds the simulation's
- * 'time_to_die', it flags the simulation as edned and returns the ID of the
- * deceased philosopher.
+ * 1. Joins the philosopher threads, or the pool's workers, and the monitor
+ *    shard threads that were created; they return once the simulation has
+ *    been flagged as ended.
+ * 2. Joins the `--metrics` thread, which writes its final snapshot.
+ * 3. Stops the log writer once it has emitted every remaining event.
  * 
- * @param sim A pointer to the main simulation structure,
- *         containing the state of all philosophers and simulation parameters.
- * @return Returns the ID of the philosopher who died.
- *         If no one has died, it returns NOT_DEAD (=0).
- */
-static int	check_for_death(t_simulation *sim)
-{
-	int			i;
-	long long	current_time;
-	long long	time_since_last_meal;
-
-	i = 0;
-	current_time = get_current_time_ms();
-	while (i < sim->philosopher_count)
-	{
-		time_since_last_meal = \
-		current_time - sim->philosophers[i].last_meal_time;
-		if (time_since_last_meal >= sim->time_to_die)
-		{
-			sim->simulation_ended = TRUE;
-			return (i + 1);
-		}
-		i++;
-	}
-	return (NOT_DEAD);
-}
-
-/**
- * @brief Checks if all philosophers have eaten the required number of meals.
- * 
- * This function determines if the simulation should end
- * because all philosophers are satisfied. It only performs the check if
- * the 'required meals' argument was provided for the simulation.
- * If every philosopher has eaten at least the required number of meals,
- * it flags the simulation as ended.
+ * After this call per-philosopher state (meal counts, stats) is final.
  * 
  * @param sim A pointer to the main simulation structure.
- * @return Returns TRUE (=1) if all philosophers have met the meal requirement.
- *         Otherwise, it returns FALSE (=0).
  */
-static int	check_all_philosophers_satisfied(t_simulation *sim)
+void	join_simulation_threads(t_simulation *sim)
 {
 	int	i;
-	int	satisfied_count;
 
-	if (sim->required_meals == -1)
-		return (FALSE);
-	i = 0;
-	satisfied_count = 0;
-	while (i < sim->philosopher_count)
-	{
-		if (sim->philosophers[i].meals_eaten >= sim->required_meals)
-			satisfied_count++;
-		i++;
-	}
-	if (satisfied_count >= sim->philosopher_count)
-	{
-		sim->simulation_ended = TRUE;
-		return (TRUE);
-	}
-	return (FALSE);
+	i = -1;
+	if (sim->options.engine != ENGINE_THREADS)
+		pool_join(sim);
+	else
+		while (++i < sim->philosopher_count)
+			if (sim->philosophers[i].started)
+				pthread_join(sim->philosophers[i].thread, NULL);
+	i = -1;
+	while (++i < sim->shard_count)
+		if (sim->shards[i].started)
+			pthread_join(sim->shards[i].thread, NULL);
+	metrics_stop(sim);
+	logger_stop(&sim->logger);
 }
 
 /**
- * @brief Evaluates the overall status of the simulation to check for
- *        end conditions.
- * 
- * This function serves as the main checker to determine if the simulation
- * should terminate. It locks the data mutex to safely access shared data,
- * then checks for the two possible end conditions in order:
+ * @brief Releases all resources of a simulation whose threads are joined.
  * 
- * 1. A philosopher has died.
- * 2. All philosophers have eaten the required number of meals.
+ * 1. Destroys the logger's and the monitor's wake-up primitives and the
+ *    fork strategy's state, and frees the `--pin` CPU list.
+ * 2. Unmaps the arena, which holds the philosophers, seats (forks), stats,
+ *    log rings, deadline heap, strategy state, pool and thread stacks, in
+ *    one go.
  * 
- * If a death is detected, it prints the status message and signals to end
- * the simulation.
+ * Works on a partially prepared simulation too, as long as it was zeroed
+ * first, so every failure path can end here.
  * 
- * @param sim A pointer to the main simulation structure.
- * @return Returns TRUE (=1) if the simulation has ended (either by death or
- *         satisfaction), otherwise returns FALSE (=0).
+ * @param sim A pointer to the main simulation structure containing
+ *            all the resources that need to be deallocated.
  */
-static int	evaluate_simulation_status(t_simulation *sim)
+void	release_simulation_resources(t_simulation *sim)
 {
-	int	dead_philosopher_id;
-	int	all_satisfied;
-
-	pthread_mutex_lock(&sim->data_mutex);
-	dead_philosopher_id = check_for_death(sim);
-	if (dead_philosopher_id > 0)
-	{
-		pthread_mutex_unlock(&sim->data_mutex);
-		print_timestamp_and_philo_status_msg(
-			&sim->philosophers[dead_philosopher_id - 1], "died", TRUE);
-		return (TRUE);
-	}
-	all_satisfied = check_all_philosophers_satisfied(sim);
-	pthread_mutex_unlock(&sim->data_mutex);
-	return (all_satisfied);
+	logger_destroy(&sim->logger);
+	pthread_mutex_destroy(&sim->monitor_mutex);
+	pthread_cond_destroy(&sim->monitor_cond);
+	fork_strategy_destroy(sim);
+	affinity_destroy(sim);
+	arena_destroy(&sim->arena);
+	sim->philosophers = NULL;
+	sim->seats = NULL;
+	sim->stats = NULL;
+	sim->deadlines.entries = NULL;
+	sim->shards = NULL;
+	sim->shard_count = 0;
+	free(sim->topology.text);
+	sim->topology.text = NULL;
+	sim->topology.offsets = NULL;
+	sim->topology.forks = NULL;
+	sim->pool.workers = NULL;
+	sim->pool.tasks = NULL;
+	sim->stacks = NULL;
 }
 
 /**
@@ -125,75 +87,58 @@ static int	evaluate_simulation_status(t_simulation *sim)
  * 
  * This function is called at the very end of the simulation to ensure
  * all allocated resources are properly freed, preventing memory 
- * and resources leaks. It performs the cleanup in the following sequence:
- * 
- * 1. Waits for all philosopher threads to complete their execution
- *    by joining them.
- * 2. Destroys all the fork mutexes.
- * 3. Destroys the global print and data mutexes.
- * 4. Frees the dynamically allocated memory for the philosophers
- *    and fork_mutexes arrays.
+ * and resources leaks. It joins every thread with join_simulation_threads(),
+ * prints the `--output=summary` line, dumps the hot-path counters in
+ * PHILO_STATS builds and then frees
+ * everything with release_simulation_resources().
  * 
  * @param sim A pointer to the main simulation structure containing
  *            all the resources that need to be deallocated.
  */
-static void	cleanup_simulation_resources(t_simulation *sim)
+void	cleanup_simulation_resources(t_simulation *sim)
 {
-	int	i;
+	join_simulation_threads(sim);
+	log_summary(sim);
+	if (PHILO_STATS)
+		stats_dump(sim);
+	release_simulation_resources(sim);
+}
 
-	i = -1;
-	while (++i < sim->philosopher_count)
-		pthread_join(sim->philosophers[i].thread, NULL);
-	i = -1;
-	while (++i < sim->philosopher_count)
-		pthread_mutex_destroy(&sim->fork_mutexes[i]);
-	pthread_mutex_destroy(&sim->print_mutex);
-	pthread_mutex_destroy(&sim->data_mutex);
-	if (sim->philosophers)
-	{
-		free(sim->philosophers);
-		sim->philosophers = NULL;
-	}
-	if (sim->fork_mutexes)
-	{
-		free(sim->fork_mutexes);
-		sim->fork_mutexes = NULL;
-	}
+/**
+ * @brief Tears down a simulation whose setup or launch failed part-way.
+ * 
+ * Ends the simulation and opens the start gate so that the threads already
+ * started return, joins them (and the log writer, if it was started) and
+ * releases everything that was set up.
+ * 
+ * @param sim A simulation zeroed before its setup started.
+ */
+void	abort_simulation(t_simulation *sim)
+{
+	end_simulation(sim);
+	start_gate_open(sim);
+	join_simulation_threads(sim);
+	release_simulation_resources(sim);
 }
 
 /**
  * @brief Monitors the simulation for end conditions and triggers cleanup.
  * 
- * This function runs in a continuous loop to monitor the simulation's state.
- * Its operation is as follows:
- * 
- * 1. It periodically calls evaluate_simulation_status() to check
- *    if a philosopher has died or if all have eaten enough.
+ * This function runs the monitor in the calling thread until the simulation
+ * ends. Its operation is as follows:
  * 
- * 2. The check interval is dynamically calculated based on time_to_dies,
- *    ensuring efficient monitoring without excessive CPU usage.
+ * 1. monitor_simulation() sleeps until the earliest death deadline or until
+ *    the last philosopher has eaten enough, and checks only what changed.
  * 
- * 3. Once an end condition is met, the loop terminates.
+ * 2. Once an end condition is met, it returns.
  * 
- * 4. Finally, it calls cleanup_simulation_resources() to free all allocated
+ * 3. Finally, it calls cleanup_simulation_resources() to free all allocated
  *    resources.
  * 
  * @param sim A pointer to the main simulation structure.
  */
 void	monitor_simulation_and_cleanup(t_simulation *sim)
 {
-	int	check_interval_us;
-
-	check_interval_us = sim->time_to_die / 10;
-	if (check_interval_us < 500)
-		check_interval_us = 500;
-	if (check_interval_us > 5000)
-		check_interval_us = 5000;
-	while (TRUE)
-	{
-		if (evaluate_simulation_status(sim) == TRUE)
-			break ;
-		usleep(check_interval_us);
-	}
+	monitor_simulation(sim);
 	cleanup_simulation_resources(sim);
 }
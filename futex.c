@@ -0,0 +1,99 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   futex.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:43:42 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:31:58 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+#include <linux/futex.h> // FUTEX_WAIT, FUTEX_WAIT_BITSET, struct futex_waitv
+#include <sys/syscall.h> // SYS_futex, SYS_futex_waitv
+#include <errno.h> // errno, ENOSYS
+
+/**
+ * @brief Sleeps on a futex word until it changes.
+ * 
+ * Returns immediately if `*word` no longer equals `expected`; like every
+ * futex wait it may also return spuriously, so callers re-check the word.
+ * 
+ * @param word The 32-bit futex word.
+ * @param expected Value the caller last saw in `word`.
+ */
+void	futex_wait(_Atomic int *word, int expected)
+{
+	syscall(SYS_futex, (int *)word, FUTEX_WAIT | FUTEX_PRIVATE_FLAG,
+		expected, NULL, NULL, 0);
+}
+
+/**
+ * @brief Sleeps on a futex word until it changes or a deadline passes.
+ * 
+ * FUTEX_WAIT_BITSET takes an absolute timeout measured against
+ * CLOCK_MONOTONIC, the time base of get_time_ns(), so there is no relative
+ * timeout to recompute and no drift after a spurious wake-up. The call
+ * returns immediately if `*word` no longer equals `expected`.
+ * 
+ * @param word The 32-bit futex word.
+ * @param expected Value the caller last saw in `word`.
+ * @param deadline Absolute wake-up time in nanoseconds.
+ */
+void	futex_wait_until(_Atomic int *word, int expected, long long deadline)
+{
+	struct timespec	timeout;
+
+	ns_to_timespec(deadline, &timeout);
+	syscall(SYS_futex, (int *)word, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG,
+		expected, &timeout, NULL, FUTEX_BITSET_MATCH_ANY);
+}
+
+/**
+ * @brief Sleeps on a futex word until it changes or a cancel flag is set.
+ * 
+ * futex_waitv() checks both words atomically, so a thread that sets
+ * `cancel` and wakes it with futex_wake_all() is never missed, and the
+ * sleeper need not know who it is. Kernels and headers before Linux 5.16
+ * lack the call; there the wait on `word` is cut into slices of
+ * FUTEX_CANCEL_POLL_NS, and `cancel` is checked between them.
+ * 
+ * @param word The 32-bit futex word.
+ * @param expected Value the caller last saw in `word`.
+ * @param cancel A flag that is FALSE while the wait should go on.
+ */
+void	futex_wait_cancellable(_Atomic int *word, int expected,
+			_Atomic int *cancel)
+{
+#ifdef SYS_futex_waitv
+	struct futex_waitv	waiters[2];
+
+	memset(waiters, 0, sizeof(waiters));
+	waiters[0].uaddr = (unsigned long)word;
+	waiters[0].val = (unsigned int)expected;
+	waiters[0].flags = FUTEX_32 | FUTEX_PRIVATE_FLAG;
+	waiters[1].uaddr = (unsigned long)cancel;
+	waiters[1].val = FALSE;
+	waiters[1].flags = FUTEX_32 | FUTEX_PRIVATE_FLAG;
+	if (syscall(SYS_futex_waitv, waiters, 2, 0, NULL, 0) == 0
+		|| errno != ENOSYS)
+		return ;
+#endif
+	while (atomic_load(word) == expected && !atomic_load(cancel))
+		futex_wait_until(word, expected,
+			get_time_ns() + FUTEX_CANCEL_POLL_NS);
+}
+
+/**
+ * @brief Wakes every thread sleeping on a futex word.
+ * 
+ * @param word The 32-bit futex word. The caller must have changed its value
+ *             before waking, so woken threads do not go back to sleep.
+ */
+void	futex_wake_all(_Atomic int *word)
+{
+	syscall(SYS_futex, (int *)word, FUTEX_WAKE | FUTEX_PRIVATE_FLAG,
+		INT_MAX, NULL, NULL, 0);
+}
@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   histogram.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:45:12 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 17:45:12 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Maps a sample to its bucket.
+ * 
+ * Values below HISTOGRAM_LINEAR map to themselves. Above that, the bucket
+ * is chosen by the position of the highest set bit and the three bits
+ * following it.
+ * 
+ * @param value The sample, clamped to be non-negative.
+ * @return The bucket index.
+ */
+static int	bucket_index(long long value)
+{
+	int	msb;
+
+	if (value < 0)
+		value = 0;
+	if (value < HISTOGRAM_LINEAR)
+		return ((int)value);
+	msb = 63 - __builtin_clzll((unsigned long long)value);
+	return (HISTOGRAM_LINEAR + (msb - 4) * HISTOGRAM_SUB_BUCKETS
+		+ (int)((value >> (msb - 3)) & (HISTOGRAM_SUB_BUCKETS - 1)));
+}
+
+/**
+ * @brief Returns the largest value that falls into a bucket.
+ * 
+ * @param index The bucket index.
+ * @return The inclusive upper bound of the bucket.
+ */
+static long long	bucket_upper_bound(int index)
+{
+	int			msb;
+	long long	lower;
+
+	if (index < HISTOGRAM_LINEAR)
+		return (index);
+	msb = (index - HISTOGRAM_LINEAR) / HISTOGRAM_SUB_BUCKETS + 4;
+	lower = (long long)(HISTOGRAM_SUB_BUCKETS
+			+ (index - HISTOGRAM_LINEAR) % HISTOGRAM_SUB_BUCKETS) << (msb - 3);
+	return (lower + (1LL << (msb - 3)) - 1);
+}
+
+/**
+ * @brief Records one sample.
+ * 
+ * @param histogram The histogram owned by the calling thread.
+ * @param value The sample in nanoseconds.
+ */
+void	histogram_record(t_histogram *histogram, long long value)
+{
+	histogram->counts[bucket_index(value)]++;
+	histogram->total++;
+}
+
+/**
+ * @brief Adds every sample of one histogram to another.
+ * 
+ * @param into The accumulating histogram.
+ * @param from The histogram to add.
+ */
+void	histogram_merge(t_histogram *into, const t_histogram *from)
+{
+	int	i;
+
+	i = -1;
+	while (++i < HISTOGRAM_BUCKETS)
+		into->counts[i] += from->counts[i];
+	into->total += from->total;
+}
+
+/**
+ * @brief Returns the value below which a given share of samples fall.
+ * 
+ * @param histogram The histogram to query.
+ * @param percentile Requested share, from 0.0 to 1.0.
+ * @return The upper bound of the bucket holding that sample, or -1 if the
+ *         histogram is empty.
+ */
+long long	histogram_percentile(const t_histogram *histogram,
+	double percentile)
+{
+	unsigned long	target;
+	unsigned long	seen;
+	int				i;
+
+	if (histogram->total == 0)
+		return (-1);
+	target = (unsigned long)(percentile * histogram->total);
+	if (target < 1)
+		target = 1;
+	seen = 0;
+	i = -1;
+	while (++i < HISTOGRAM_BUCKETS)
+	{
+		seen += histogram->counts[i];
+		if (seen >= target)
+			break ;
+	}
+	return (bucket_upper_bound(i));
+}
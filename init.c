@@ -6,7 +6,7 @@
 /*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/07/04 18:56:58 by hoskim            #+#    #+#             */
-/*   Updated: 2025/07/11 14:09:49 by hoskim           ###   ########seoul.kr  */
+/*   Updated: 2026/10/14 19:27:08 by hoskim           ###   ########seoul.kr  */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -32,7 +32,7 @@
  * @return Returns SUCCESS (=0) if parsing is successful, otherwise prints an
  *         error message and returns an error code.
  */
-static int	parse_cmd_line_args(t_simulation *sim, int argc, char *argv[])
+int	parse_cmd_line_args(t_simulation *sim, int argc, char *argv[])
 {
 	if (argc != 5 && argc != 6)
 		return (print_error("Error: Wrong number of arguments\n"));
@@ -53,18 +53,21 @@ static int	parse_cmd_line_args(t_simulation *sim, int argc, char *argv[])
 	}
 	else
 		sim->required_meals = -1;
-	sim->simulation_ended = FALSE;
 	return (SUCCESS);
 }
 
 /**
  * @brief Initializes the philosophers and fork mutexes for the simulation.
  * 
- * This function allocates memory for all the philosopher structures and the
- * corresponding fork mutexes. It then initializes each philosopher with their
- * unique ID, the indices for their left and right forks, a pointer to the
- * main simulation structure, and initial values for their meal  count and
- * last meal time.
+ * This function carves all the philosopher structures and the
+ * corresponding seats out of the simulation's arena, whose blocks are
+ * cache-line-aligned, so that every philosopher's meal state and every fork
+ * lock starts on its own cache line.
+ * It then initializes each philosopher with their unique ID, the indices
+ * for their left and right forks, a pointer to their seat and to the main
+ * simulation structure, splits the death deadlines among the monitor
+ * shards and lays out the `--topology`, which lists the forks each
+ * philosopher actually needs.
  * 
  * @param sim A pointer to the main simulation structure (t_simulation).
  * @return Returns SUCCESS (=0) if initialization is successful, otherwise prints
@@ -75,10 +78,10 @@ static int	setup_philosophers(t_simulation *sim)
 {
 	int	i;
 
-	sim->philosophers = malloc(sizeof(t_philosopher) * sim->philosopher_count);
-	sim->fork_mutexes = malloc(
-			sizeof(pthread_mutex_t) * sim->philosopher_count);
-	if (!sim->philosophers || !sim->fork_mutexes)
+	sim->philosophers = arena_alloc(&sim->arena,
+			sizeof(t_philosopher) * sim->philosopher_count);
+	sim->seats = arena_alloc(&sim->arena, sizeof(t_seat) * sim->seat_count);
+	if (!sim->philosophers || !sim->seats)
 		return (print_error("Error: Memory allocation failed\n"));
 	i = 0;
 	while (i < sim->philosopher_count)
@@ -87,20 +90,26 @@ static int	setup_philosophers(t_simulation *sim)
 		sim->philosophers[i].left_fork_index = i;
 		sim->philosophers[i].right_fork_index = \
 		(i + 1) % sim->philosopher_count;
+		sim->philosophers[i].seat = &sim->seats[i];
 		sim->philosophers[i].simulation = sim;
-		sim->philosophers[i].meals_eaten = 0;
-		sim->philosophers[i].last_meal_time = 0;
+		sim->philosophers[i].log_ring = &sim->logger.rings[i];
 		i++;
 	}
-	return (SUCCESS);
+	if (deadline_heap_init(&sim->deadlines, &sim->arena,
+			sim->philosopher_count) != SUCCESS
+		|| monitor_shards_init(sim) != SUCCESS)
+		return (FAILURE);
+	return (topology_init(sim));
 }
 
 /**
  * @brief Initializes all the mutexes required for the simulation.
  * 
- * This function initializes a mutex for each fork, a mutex for controlling
- * print statements (to prevent garbled output), and a mutex for protecting
- * shared data within the simulation structure.
+ * This function initializes the FIFO lock of each fork together with the
+ * seat's meal state, the shared flags and counters, and the
+ * mutex/condition pair the monitor sleeps on. Output goes through the asynchronous logger
+ * and shared per-philosopher data and the end flag are atomics, so no other
+ * mutex is needed.
  * 
  * @param sim A pointer to the t_simulation struct which holds all simulation
  *            data, including the mutexes to be initialized.
@@ -113,44 +122,105 @@ static int	initialize_mutexes(t_simulation *sim)
 	int	i;
 
 	i = 0;
-	while (i < sim->philosopher_count)
+	while (i < sim->seat_count)
 	{
-		if (pthread_mutex_init(&sim->fork_mutexes[i], NULL) != SUCCESS)
-			return (print_error("Error: Fork mutex initialization failed.\n"));
+		fork_lock_init(&sim->seats[i].fork);
+		atomic_init(&sim->seats[i].fork_state, FORK_FREE);
+		atomic_init(&sim->seats[i].meals_eaten, 0);
+		atomic_init(&sim->seats[i].last_meal_time, 0);
 		i++;
 	}
-	if (pthread_mutex_init(&sim->print_mutex, NULL) != SUCCESS)
-		return (print_error("Error: Print mutex initialization failed.\n"));
-	if (pthread_mutex_init(&sim->data_mutex, NULL) != SUCCESS)
-		return (print_error("Error: Data mutex initialization failed.\n"));
+	atomic_init(&sim->simulation_ended, FALSE);
+	atomic_init(&sim->satisfied_count, 0);
+	sim->death_latency_ns = -1;
+	sim->launched = 0;
+	sim->sleep_spin_ns = SLEEP_SPIN_NS;
+	if (sim->philosopher_count > sysconf(_SC_NPROCESSORS_ONLN))
+		sim->sleep_spin_ns = 0;
+	atomic_init(&sim->start_gate, FALSE);
+	if (pthread_mutex_init(&sim->monitor_mutex, NULL) != SUCCESS
+		|| init_monotonic_cond(&sim->monitor_cond) != SUCCESS)
+		return (print_error("Error: Monitor initialization failed.\n"));
 	return (SUCCESS);
 }
 
 /**
- * @brief Initializes the entire simulation structrue.
+ * @brief Allocates and initializes the simulation state for a configuration.
  * 
- * This function serves as the main entry point for initialization.
+ * The configuration fields (`philosopher_count`, the three timings,
+ * `required_meals`, `time_limit_ms` and `options`) must already be set,
+ * either parsed from the command line or filled in by the benchmark.
  * It calls helper functions in sequence to:
- * 1. Parse the command-line arguments.
- * 2. Set up the philosopher structures and fork mutexes.
- * 3. Initialize all necessary mutexes for synchronization.
+ * 1. Check the `--topology`, map one arena sized for all the state below,
+ *    plus the thread stacks of `--stack-size`, and set up the logger in
+ *    it with one ring per producer thread: per philosopher, or per worker
+ *    with `--engine=pool`, and open the `--trace-file`, if any.
+ * 2. Set up the philosopher structures, seats and per-philosopher stats.
+ * 3. Initialize the forks, the shared flags and counters and all
+ *    necessary mutexes for synchronization.
+ * 4. Set up the state of the `--strategy` fork strategy.
+ * 5. Set up the worker pool if `--engine=pool` was given.
+ * 6. With `--pin`, list the CPUs by NUMA node and move each philosopher's
+ *    state to the node their thread will run on.
  * If any of these steps fail, the function will immediately abort the
- * initialization process and return a failure status.
+ * initialization process and return a failure status; the caller then
+ * calls release_simulation_resources(), which copes with a partial setup.
+ * 
+ * @param sim A pointer to the configured simulation structure.
+ * @return Returns SUCCESS (=0) if the simulation is ready to be launched.
+ *         Otherwise, it returns FAILURE (=1).
+ */
+int	prepare_simulation(t_simulation *sim)
+{
+	int		ring_count;
+	size_t	capacity;
+
+	ring_count = sim->philosopher_count;
+	capacity = LOG_RING_CAPACITY;
+	if (sim->options.engine != ENGINE_THREADS)
+	{
+		ring_count = pool_worker_count(sim);
+		capacity = LOG_POOL_RING_CAPACITY;
+	}
+	if (simulation_arena_init(sim, ring_count, capacity) != SUCCESS
+		|| logger_init(&sim->logger, &sim->arena, ring_count, capacity)
+		!= SUCCESS
+		|| log_file_open(&sim->logger, sim->options.trace_path) != SUCCESS
+		|| setup_philosophers(sim) != SUCCESS
+		|| stats_init(sim) != SUCCESS
+		|| initialize_mutexes(sim) != SUCCESS
+		|| fork_strategy_init(sim) != SUCCESS
+		|| (sim->options.engine != ENGINE_THREADS && pool_init(sim) != SUCCESS)
+		|| affinity_init(sim) != SUCCESS)
+		return (FAILURE);
+	sim->logger.halt = &sim->simulation_ended;
+	sim->logger.format = sim->options.trace_format;
+	affinity_bind_memory(sim);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Initializes the entire simulation structrue.
+ * 
+ * This function serves as the main entry point for initialization.
+ * It stores the parsed `--options`, parses the positional command-line
+ * arguments and then prepares the simulation state with
+ * prepare_simulation().
  * 
  * @param sim A pointer to the main simulation structure (t_simulation) that
  *            will be populated with the simulation's configuration.
- * @param argc The count of command-line arguments passed to the program.
- * @param argv The array of command-line argument strings.
+ * @param options The options parsed by parse_options().
+ * @param argc The count of positional arguments, plus one for argv[0].
+ * @param argv The positional arguments, starting at argv[1].
  * @return Returns SUCCESS (=0) if the entire simulation is
  *         initialized successfully. Otherwise, it returns FAILURE (=1).
  */
-int	initialize_simulation(t_simulation *sim, int argc, char *argv[])
+int	initialize_simulation(t_simulation *sim, const t_options *options,
+	int argc, char *argv[])
 {
+	memset(sim, 0, sizeof(t_simulation));
+	sim->options = *options;
 	if (parse_cmd_line_args(sim, argc, argv) != SUCCESS)
 		return (FAILURE);
-	if (setup_philosophers(sim) != SUCCESS)
-		return (FAILURE);
-	if (initialize_mutexes(sim) != SUCCESS)
-		return (FAILURE);
-	return (SUCCESS);
+	return (prepare_simulation(sim));
 }
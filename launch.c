@@ -0,0 +1,160 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   launch.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:45:19 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:53:32 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+
+#include "philo.h"
+
+/**
+ * @brief Sets up launcher `k` of `count`, which creates the `k`-th of
+ *        `count` contiguous ranges of philosophers.
+ * 
+ * Contiguous ranges keep the creation (and start gate wake-up) order of
+ * neighbours close to a single launcher's, and with `--pin` put each
+ * launcher on the philosophers of one node.
+ * 
+ * @param launcher The launcher to set up.
+ * @param sim The simulation being launched.
+ * @param k Index of the launcher.
+ * @param count Number of launchers.
+ */
+static void	launcher_init(t_launcher *launcher, t_simulation *sim, int k,
+	int count)
+{
+	memset(launcher, 0, sizeof(t_launcher));
+	launcher->simulation = sim;
+	launcher->first = (long long)sim->philosopher_count * k / count;
+	launcher->end = (long long)sim->philosopher_count * (k + 1) / count;
+	launcher->status = SUCCESS;
+}
+
+/**
+ * @brief Creates the threads of philosophers [`first`, `end`), each parked
+ *        at the start gate until the launch completes.
+ * 
+ * A thread's `started` flag is set once it exists, so a failed launch
+ * joins exactly the threads that were created.
+ * 
+ * @param launcher The philosophers to start and where to report status.
+ * @return Returns SUCCESS (=0), or FAILURE (=1) after printing an error.
+ */
+static int	create_philosopher_threads(t_launcher *launcher)
+{
+	pthread_attr_t	attr;
+	t_philosopher	*philo;
+	int				i;
+
+	i = launcher->first;
+	while (i < launcher->end)
+	{
+		philo = &launcher->simulation->philosophers[i];
+		if (thread_attr_init(launcher->simulation, i,
+				launcher->simulation->philosopher_count, &attr) != SUCCESS)
+			return (FAILURE);
+		philo->started = !pthread_create(&philo->thread, &attr,
+				philosopher_lifecycle, philo);
+		pthread_attr_destroy(&attr);
+		if (!philo->started)
+			return (print_error(
+					"Error: Failed to create philosopher thread.\n"));
+		i++;
+	}
+	return (SUCCESS);
+}
+
+/**
+ * @brief Routine of a `--launchers` thread.
+ * 
+ * @param arg Pointer to the t_launcher.
+ * @return NULL on thread completion.
+ */
+static void	*launcher_routine(void *arg)
+{
+	t_launcher	*launcher;
+
+	launcher = (t_launcher *)arg;
+	launcher->status = create_philosopher_threads(launcher);
+	return (NULL);
+}
+
+/**
+ * @brief Creates the philosopher threads from `--launchers=N` threads.
+ * 
+ * Each launcher creates one contiguous range of philosophers; the range
+ * of a launcher that fails to start is created by the calling thread.
+ * 
+ * @param sim The simulation being launched.
+ * @param count Number of launchers, at most LAUNCHERS_MAX.
+ * @return Returns SUCCESS (=0), or FAILURE (=1) if a thread failed.
+ */
+static int	create_in_parallel(t_simulation *sim, int count)
+{
+	t_launcher	launchers[LAUNCHERS_MAX];
+	int			status;
+	int			k;
+
+	status = SUCCESS;
+	k = -1;
+	while (++k < count)
+	{
+		launcher_init(&launchers[k], sim, k, count);
+		if (pthread_create(&launchers[k].thread, NULL, launcher_routine,
+				&launchers[k]) != SUCCESS)
+			launcher_routine(&launchers[k]);
+		else
+			launchers[k].started = TRUE;
+	}
+	while (k-- > 0)
+	{
+		if (launchers[k].started)
+			pthread_join(launchers[k].thread, NULL);
+		status |= launchers[k].status;
+	}
+	return (status);
+}
+
+/**
+ * @brief Launches all philosopher threads and sets the simulation start time.
+ * 
+ * Every philosopher thread (or, with `--engine=pool`, every worker) is
+ * created first, from the calling thread or from `--launchers=N` threads
+ * in parallel, and parks at the start gate. Only then is the start time
+ * taken, every `last_meal_time` set to it and the log writer started,
+ * and the gate opened, so the cost of creating thousands of threads does
+ * not eat into the first death deadlines.
+ * 
+ * @param sim A pointer to the simulation structure,
+ *            containing all simulation data.
+ * @return Returns `SUCCESS` if all threads are created successfully. Otherwise,
+ *         it prints an error message and returns an error code; the threads
+ *         already created stay parked until abort_simulation() opens the gate.
+ * 
+ */
+int	launch_philosopher_threads(t_simulation *sim)
+{
+	t_launcher	launcher;
+	int			status;
+
+	if (sim->options.engine == ENGINE_VIRTUAL)
+		return (virtual_start(sim));
+	if (sim->options.engine == ENGINE_POOL)
+		status = pool_start(sim);
+	else if (sim->options.launchers > 1)
+		status = create_in_parallel(sim, sim->options.launchers);
+	else
+	{
+		launcher_init(&launcher, sim, 0, 1);
+		status = create_philosopher_threads(&launcher);
+	}
+	if (status != SUCCESS)
+		return (FAILURE);
+	return (start_simulation_clock(sim));
+}
@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log.c                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:40:08 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:01:38 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Initializes the logger and carves its producer rings, their records,
+ *        the merge heap and the output buffer out of an arena.
+ * 
+ * The caller then points `halt` at the flag after which producers silently
+ * drop their events (the simulation's `simulation_ended`).
+ * 
+ * @param logger The logger to initialize.
+ * @param arena The arena, sized with room for the logger.
+ * @param ring_count Number of producer threads, one ring each.
+ * @param capacity Records per ring, a power of two.
+ * @return Returns SUCCESS (=0) on success, otherwise prints an error message
+ *         and returns an error code.
+ */
+int	logger_init(t_logger *logger, t_arena *arena, int ring_count,
+	size_t capacity)
+{
+	int	i;
+
+	memset(logger, 0, sizeof(t_logger));
+	logger->rings = arena_alloc(arena, sizeof(t_log_ring) * ring_count);
+	logger->records = arena_alloc(arena,
+			sizeof(t_log_record) * capacity * ring_count);
+	logger->heap = arena_alloc(arena, sizeof(int) * ring_count);
+	logger->buffer = arena_alloc(arena, LOG_BATCH_BYTES);
+	if (!logger->rings || !logger->records || !logger->heap
+		|| !logger->buffer)
+		return (print_error("Error: Memory allocation failed\n"));
+	i = -1;
+	while (++i < ring_count)
+		log_ring_init(&logger->rings[i], &logger->records[capacity * i]);
+	logger->ring_count = ring_count;
+	logger->capacity = capacity;
+	atomic_init(&logger->death_posted, FALSE);
+	atomic_init(&logger->closed, FALSE);
+	atomic_init(&logger->stop, FALSE);
+	if (pthread_mutex_init(&logger->wake_mutex, NULL) != SUCCESS
+		|| init_monotonic_cond(&logger->wake_cond) != SUCCESS)
+		return (print_error("Error: Logger initialization failed.\n"));
+	return (SUCCESS);
+}
+
+/**
+ * @brief Starts the writer thread, which a `--trace-file` does not need.
+ * 
+ * @param logger The initialized logger.
+ * @param start_time Simulation start time; output timestamps are relative
+ *                   to it and every ring's horizon bound starts there.
+ * @return Returns SUCCESS (=0) if the thread was created, otherwise prints an
+ *         error message and returns an error code.
+ */
+int	logger_start(t_logger *logger, long long start_time)
+{
+	int	i;
+
+	logger->start_time = start_time;
+	i = -1;
+	while (++i < logger->ring_count)
+		atomic_store_explicit(&logger->rings[i].last_timestamp, start_time,
+			memory_order_relaxed);
+	if (logger->file.open)
+		return (SUCCESS);
+	if (pthread_create(&logger->thread, NULL, log_writer_routine, logger)
+		!= SUCCESS)
+		return (print_error("Error: Failed to create log writer thread.\n"));
+	logger->running = TRUE;
+	return (SUCCESS);
+}
+
+/**
+ * @brief Hands the death record to the writer and wakes it immediately.
+ * 
+ * The caller must have ended the simulation first, so that producers stop
+ * publishing new events.
+ * 
+ * @param logger The running logger.
+ * @param philo_id ID of the philosopher who died.
+ * @param now Time of death in nanoseconds.
+ */
+void	log_post_death(t_logger *logger, int philo_id, long long now)
+{
+	logger->death.timestamp = now;
+	logger->death.philo_id = philo_id;
+	logger->death.event = LOG_DIED;
+	atomic_store(&logger->death_posted, TRUE);
+	pthread_mutex_lock(&logger->wake_mutex);
+	pthread_cond_signal(&logger->wake_cond);
+	pthread_mutex_unlock(&logger->wake_mutex);
+}
+
+/**
+ * @brief Asks the writer to drain everything and waits for it to exit.
+ * 
+ * Must be called after all producers have been joined. Does nothing if
+ * the writer was never started.
+ * 
+ * @param logger The logger.
+ */
+void	logger_stop(t_logger *logger)
+{
+	if (!logger->running)
+		return ;
+	logger->running = FALSE;
+	atomic_store(&logger->stop, TRUE);
+	pthread_mutex_lock(&logger->wake_mutex);
+	pthread_cond_signal(&logger->wake_cond);
+	pthread_mutex_unlock(&logger->wake_mutex);
+	pthread_join(logger->thread, NULL);
+}
+
+/**
+ * @brief Closes the trace file, if any, and destroys the logger's wake-up
+ *        primitives; its memory belongs to the arena it was carved from.
+ * 
+ * @param logger The stopped logger.
+ */
+void	logger_destroy(t_logger *logger)
+{
+	log_file_close(logger);
+	pthread_mutex_destroy(&logger->wake_mutex);
+	pthread_cond_destroy(&logger->wake_cond);
+	logger->rings = NULL;
+	logger->records = NULL;
+	logger->heap = NULL;
+	logger->buffer = NULL;
+}
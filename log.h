@@ -0,0 +1,200 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log.h                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:38:53 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:29:20 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef LOG_H
+# define LOG_H
+
+# include <pthread.h> // pthread_t, pthread_mutex_t, pthread_cond_t
+# include <stdatomic.h> // _Atomic
+# include <stddef.h> // size_t
+# include "arena.h"
+
+# define CACHE_LINE_SIZE 64
+# define LOG_RING_CAPACITY 256
+// ^^^ Records per philosopher thread's ring; must be a power of two.
+# define LOG_POOL_RING_CAPACITY 65536
+// ^^^ Records per pool worker's ring, which many philosophers share.
+# define LOG_BATCH_BYTES 65536 // < Size of the writer's output buffer.
+# define LOG_FLUSH_INTERVAL_US 1000 // < Writer idle period between drains.
+# define LOG_FULL_BACKOFF_US 50 // < Producer backoff while its ring is full.
+# define LOG_MAX_LINE 64 // < Upper bound of one formatted line.
+# define LOG_FORMAT_TEXT 0 // < "timestamp id message" lines (the default).
+# define LOG_FORMAT_BINARY 1 // < Compact trace, see log_binary.c.
+# define LOG_TRACE_MAGIC "PHTRACE1" // < First bytes of a binary trace.
+# define LOG_TRACE_MAGIC_SIZE 8
+# define LOG_BLOCK_TAG 'B' // < First byte of every block header.
+# define LOG_BLOCK_HEADER 17 // < Tag, u32 length, u32 count, i64 base.
+# define LOG_FILE_MAGIC "PHTRACEF" // < First bytes of a `--trace-file`.
+# define LOG_FILE_SEGMENT_BYTES 67108864 // < Trace file mapping unit.
+// ^^^ Also the file's size before growth; a multiple of the slot size.
+# define LOG_FILE_MAX_SEGMENTS 4096 // < Trace file size limit (256 GiB).
+# define LOG_SLOT_COMMITTED 0xC5 // < `committed` byte of a complete slot.
+
+/**
+ * @brief Event codes carried by a log record.
+ * 
+ * The writer thread turns these back into the textual status messages, so a
+ * producer never formats anything on its hot path.
+ */
+typedef enum e_log_event
+{
+	LOG_TAKEN_FORK,
+	LOG_TAKEN_LEFT_FORK,
+	LOG_TAKEN_RIGHT_FORK,
+	LOG_EATING,
+	LOG_SLEEPING,
+	LOG_THINKING,
+	LOG_DIED,
+	LOG_EVENT_COUNT
+}	t_log_event;
+
+# define LOG_FORK_EVENTS 7U // < Bits of the three LOG_TAKEN_* events.
+
+/**
+ * @brief Fixed-size record pushed by a producer.
+ */
+typedef struct s_log_record
+{
+	long long	timestamp; // < Absolute event time in nanoseconds.
+	int			philo_id; // < Philosopher the event belongs to.
+	int			event; // < One of t_log_event.
+}	t_log_record;
+
+/**
+ * @brief One record of a `--trace-file`, written in place by its producer.
+ * 
+ * `committed` is stored last, with release semantics, so a slot whose
+ * byte reads LOG_SLOT_COMMITTED is complete even if the process was
+ * killed right after; everything up to the first other slot is valid.
+ */
+typedef struct s_log_slot
+{
+	long long				timestamp; // < Nanoseconds from the start.
+	int						philo_id; // < Philosopher the event belongs to.
+	unsigned char			event; // < One of t_log_event.
+	unsigned char			reserved[2]; // < Zero.
+	_Atomic unsigned char	committed; // < LOG_SLOT_COMMITTED once written.
+}	t_log_slot;
+
+/**
+ * @brief A memory-mapped trace file shared by all producers.
+ * 
+ * The file is grown with ftruncate() as reservations reach its end, and
+ * each new LOG_FILE_SEGMENT_BYTES of it gets its own mapping, so the
+ * address space in use follows the file and no mapping ever moves.
+ * Slot 0 holds the header (LOG_FILE_MAGIC and the slot size).
+ */
+typedef struct s_log_file
+{
+	char				**segments; // < LOG_FILE_MAX_SEGMENTS mappings.
+	size_t				mapped; // < Segments mapped so far.
+	int					fd; // < The open file.
+	int					open; // < Whether `fd` and `grow_mutex` are set up.
+	_Atomic size_t		next; // < Next slot to reserve, minus the header.
+	_Atomic size_t		size; // < Current length of the file in bytes.
+	pthread_mutex_t		grow_mutex; // < Serializes growing the file.
+}	t_log_file;
+
+/**
+ * @brief Single-producer / single-consumer ring of log records.
+ * 
+ * The producer owns `head`, `last_timestamp` and `in_flight`; the writer
+ * owns `tail`. The two halves live on separate cache lines.
+ * `in_flight` is raised for the whole time between the producer taking its
+ * timestamp and publishing the record, which lets the writer compute a safe
+ * horizon for its timestamp-ordered merge (see log_safe_horizon()).
+ */
+typedef struct s_log_ring
+{
+	_Atomic size_t		head;
+	_Atomic long long	last_timestamp;
+	_Atomic int			in_flight;
+	t_log_record		*records; // < `capacity` records of the logger.
+	_Alignas(CACHE_LINE_SIZE) _Atomic size_t	tail;
+}	t_log_ring;
+
+/**
+ * @brief Asynchronous log writer shared by all producers.
+ * 
+ * Each producer thread pushes into its own ring. One writer thread merges
+ * the rings in timestamp order and emits the text with batched write(2)
+ * calls. The death record bypasses the rings: once it is posted the writer
+ * emits everything older, then the death line, and stops for good.
+ */
+typedef struct s_logger
+{
+	t_log_ring		*rings; // < One ring per producer thread.
+	int				ring_count; // < Number of rings.
+	size_t			capacity; // < Records per ring, a power of two.
+	t_log_record	*records; // < Storage of all rings' records.
+	int				*heap; // < Scratch min-heap of ring indices for merging.
+	int				heap_size; // < Current number of heap entries.
+	char			*buffer; // < Pending output bytes.
+	size_t			length; // < Number of bytes used in `buffer`.
+	long long		start_time; // < Simulation start, subtracted on output.
+	int				format; // < LOG_FORMAT_TEXT or LOG_FORMAT_BINARY.
+	int				magic_written; // < Whether the trace magic was emitted.
+	size_t			block_start; // < Offset of the open block's header.
+	long			block_count; // < Records in the open block, 0 if none.
+	long long		block_base; // < Time of the block's first record.
+	long long		block_last; // < Time of its latest record.
+	_Atomic int		*halt; // < Producers drop events once this is set.
+	t_log_record	death; // < The death record, valid once posted.
+	_Atomic int		death_posted; // < Set by log_post_death().
+	_Atomic int		closed; // < Set once the writer emitted its last line.
+	_Atomic int		stop; // < Asks the writer to drain everything and exit.
+	pthread_t		thread; // < Writer thread handle.
+	int				running; // < TRUE between logger_start() and stop.
+	pthread_mutex_t	wake_mutex; // < Protects the wakeup of the writer.
+	pthread_cond_t	wake_cond; // < Signalled on death and on stop.
+	t_log_file		file; // < `--trace-file` sink, bypassing the rings.
+}	t_logger;
+
+// log.c
+int			logger_init(t_logger *logger, t_arena *arena, int ring_count,
+				size_t capacity);
+int			logger_start(t_logger *logger, long long start_time);
+void		log_post_death(t_logger *logger, int philo_id, long long now);
+void		logger_stop(t_logger *logger);
+void		logger_destroy(t_logger *logger);
+
+// log_ring.c
+void		log_ring_init(t_log_ring *ring, t_log_record *records);
+int			log_ring_push(t_logger *logger, t_log_ring *ring,
+				t_log_record *entry);
+long long	log_safe_horizon(t_logger *logger, long long now);
+int			log_ring_front(t_logger *logger, int index,
+				long long horizon, t_log_record **record);
+void		log_ring_consume(t_logger *logger, int index);
+
+// log_merge.c
+void		log_drain(t_logger *logger, long long horizon);
+long		log_backlog(t_logger *logger);
+
+// log_format.c
+void		log_append_record(t_logger *logger, const t_log_record *record);
+void		log_flush(t_logger *logger);
+
+// log_file.c
+int			log_file_open(t_logger *logger, const char *path);
+void		log_file_append(t_logger *logger, int philo_id, int event,
+				long long timestamp);
+void		log_file_close(t_logger *logger);
+
+// log_binary.c
+void		log_append_binary(t_logger *logger, const t_log_record *record);
+void		log_seal_block(t_logger *logger);
+
+// log_writer.c
+void		*log_writer_routine(void *arg);
+
+#endif
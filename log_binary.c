@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log_binary.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:57:17 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:58:21 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Binary trace layout (`--trace=binary`), all integers little-endian:
+ * 
+ *   LOG_TRACE_MAGIC, then blocks of
+ *   'B' | u32 payload bytes | u32 records | i64 base | payload
+ * 
+ * `base` is the time of the block's first record in nanoseconds from the
+ * simulation start; each record of the payload is a zigzag varint delta
+ * to the previous record's time (the first one's is 0), a varint
+ * philosopher ID and a one-byte t_log_event. Blocks are self-contained,
+ * and one block is written per flush. philo-decode (decode.c) turns a
+ * trace back into the text output.
+ */
+
+/**
+ * @brief Appends an unsigned LEB128 varint to the buffer.
+ * 
+ * @param logger The logger whose buffer is extended.
+ * @param value The value to append.
+ */
+static void	append_varint(t_logger *logger, unsigned long long value)
+{
+	while (value >= 0x80)
+	{
+		logger->buffer[logger->length++] = (char)(value | 0x80);
+		value >>= 7;
+	}
+	logger->buffer[logger->length++] = (char)value;
+}
+
+/**
+ * @brief Stores a little-endian integer of `bytes` bytes.
+ * 
+ * @param out Where to store it.
+ * @param value The value.
+ * @param bytes Its width in bytes.
+ */
+static void	store_le(char *out, unsigned long long value, int bytes)
+{
+	int	i;
+
+	i = -1;
+	while (++i < bytes)
+	{
+		out[i] = (char)(value & 0xFF);
+		value >>= 8;
+	}
+}
+
+/**
+ * @brief Encodes one record into the open block, opening one if needed.
+ * 
+ * The first block of the run is preceded by LOG_TRACE_MAGIC. The header
+ * is only reserved here and filled in by log_seal_block().
+ * 
+ * @param logger The logger whose buffer receives the record.
+ * @param record The record to encode.
+ */
+void	log_append_binary(t_logger *logger, const t_log_record *record)
+{
+	long long	time;
+	long long	delta;
+
+	time = record->timestamp - logger->start_time;
+	if (logger->block_count == 0)
+	{
+		if (!logger->magic_written)
+		{
+			memcpy(logger->buffer + logger->length, LOG_TRACE_MAGIC,
+				LOG_TRACE_MAGIC_SIZE);
+			logger->length += LOG_TRACE_MAGIC_SIZE;
+			logger->magic_written = TRUE;
+		}
+		logger->block_start = logger->length;
+		logger->length += LOG_BLOCK_HEADER;
+		logger->block_base = time;
+		logger->block_last = time;
+	}
+	delta = time - logger->block_last;
+	append_varint(logger, (unsigned long long)(delta << 1 ^ delta >> 63));
+	append_varint(logger, (unsigned int)record->philo_id);
+	logger->buffer[logger->length++] = (char)record->event;
+	logger->block_last = time;
+	logger->block_count++;
+}
+
+/**
+ * @brief Fills in the header of the open block, which is then complete.
+ * 
+ * @param logger The logger about to flush; nothing happens without an
+ *               open block.
+ */
+void	log_seal_block(t_logger *logger)
+{
+	char	*header;
+
+	if (logger->block_count == 0)
+		return ;
+	header = logger->buffer + logger->block_start;
+	header[0] = LOG_BLOCK_TAG;
+	store_le(header + 1,
+		logger->length - logger->block_start - LOG_BLOCK_HEADER, 4);
+	store_le(header + 5, logger->block_count, 4);
+	store_le(header + 9, logger->block_base, 8);
+	logger->block_count = 0;
+}
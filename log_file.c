@@ -0,0 +1,195 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log_file.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:59:22 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:11:00 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+#include <fcntl.h> // open()
+#include <sys/mman.h> // mmap(), munmap()
+
+/**
+ * @brief Grows the file, doubling it, until it holds `need` bytes, and
+ *        maps the new segments.
+ * 
+ * The new size is published only once its segments are mapped, so a
+ * producer who sees it also sees the mappings.
+ * 
+ * @param file The trace file.
+ * @param need Required length in bytes.
+ * @return TRUE (=1) if the file is now long enough, FALSE (=0) if it hit
+ *         the LOG_FILE_MAX_SEGMENTS limit or could not be grown or mapped
+ *         (e.g. disk full).
+ */
+static int	grow_file(t_log_file *file, size_t need)
+{
+	size_t	size;
+	char	*segment;
+	int		grown;
+
+	pthread_mutex_lock(&file->grow_mutex);
+	size = atomic_load(&file->size);
+	if (size == 0)
+		size = LOG_FILE_SEGMENT_BYTES;
+	while (size < need && size < (size_t)LOG_FILE_SEGMENT_BYTES
+		* LOG_FILE_MAX_SEGMENTS)
+		size *= 2;
+	grown = (size > atomic_load(&file->size) && size >= need
+			&& ftruncate(file->fd, size) == SUCCESS);
+	while (grown && file->mapped * LOG_FILE_SEGMENT_BYTES < size)
+	{
+		segment = mmap(NULL, LOG_FILE_SEGMENT_BYTES, PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_NORESERVE, file->fd,
+				file->mapped * LOG_FILE_SEGMENT_BYTES);
+		grown = (segment != MAP_FAILED);
+		if (grown)
+			file->segments[file->mapped++] = segment;
+	}
+	if (grown)
+		atomic_store(&file->size, size);
+	pthread_mutex_unlock(&file->grow_mutex);
+	return (atomic_load(&file->size) >= need);
+}
+
+/**
+ * @brief Creates the trace file and maps it for every producer.
+ * 
+ * The file starts at one LOG_FILE_SEGMENT_BYTES segment; untouched pages
+ * of a mapping cost nothing. The header goes into slot 0.
+ * 
+ * @param logger An initialized logger.
+ * @param path Path of the trace file, which is truncated; NULL for none.
+ * @return SUCCESS (=0), or FAILURE (=1) after printing an error.
+ */
+int	log_file_open(t_logger *logger, const char *path)
+{
+	t_log_file	*file;
+
+	if (!path)
+		return (SUCCESS);
+	file = &logger->file;
+	file->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (file->fd < 0)
+		return (print_error("Error: Cannot open the trace file.\n"));
+	pthread_mutex_init(&file->grow_mutex, NULL);
+	file->open = TRUE;
+	atomic_init(&file->next, 0);
+	atomic_init(&file->size, 0);
+	file->segments = calloc(LOG_FILE_MAX_SEGMENTS, sizeof(char *));
+	if (!file->segments)
+		return (print_error("Error: Trace file allocation failed.\n"));
+	if (!grow_file(file, LOG_FILE_SEGMENT_BYTES))
+		return (print_error("Error: Cannot map the trace file.\n"));
+	memcpy(file->segments[0], LOG_FILE_MAGIC, LOG_TRACE_MAGIC_SIZE);
+	file->segments[0][LOG_TRACE_MAGIC_SIZE] = sizeof(t_log_slot);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Writes one event straight into the trace file.
+ * 
+ * A single fetch-add reserves the slot, so producers never wait for each
+ * other (or for a writer thread) unless the file has to grow; the record
+ * is written in place and committed by its last byte. Slots are in
+ * reservation order, which follows the timestamps only up to the moment
+ * between reading the clock and reserving; philo-decode sorts them back
+ * into time order. Like log_ring_push(), events
+ * after the end of the simulation are dropped, except for the death.
+ * 
+ * @param logger A logger with an open trace file.
+ * @param philo_id ID of the philosopher the event belongs to.
+ * @param event One of t_log_event.
+ * @param timestamp Absolute event time in nanoseconds.
+ */
+void	log_file_append(t_logger *logger, int philo_id, int event,
+	long long timestamp)
+{
+	t_log_slot	*slot;
+	size_t		end;
+
+	if (event != LOG_DIED
+		&& atomic_load_explicit(logger->halt, memory_order_acquire))
+		return ;
+	end = (atomic_fetch_add_explicit(&logger->file.next, 1,
+				memory_order_relaxed) + 2) * sizeof(t_log_slot);
+	if (end > atomic_load_explicit(&logger->file.size, memory_order_acquire)
+		&& !grow_file(&logger->file, end))
+		return ;
+	end -= sizeof(t_log_slot);
+	slot = (t_log_slot *)(logger->file.segments[end / LOG_FILE_SEGMENT_BYTES]
+			+ end % LOG_FILE_SEGMENT_BYTES);
+	slot->timestamp = timestamp - logger->start_time;
+	slot->philo_id = philo_id;
+	slot->event = (unsigned char)event;
+	atomic_store_explicit(&slot->committed, LOG_SLOT_COMMITTED,
+		memory_order_release);
+}
+
+/**
+ * @brief Logs one event without going through the rings and the writer.
+ * 
+ * With `--trace-file` the event goes straight into the file. Otherwise
+ * this is `--engine=virtual`: there is a single thread and events happen
+ * in time order, so the event is formatted at the simulated time right
+ * into the batch buffer, and, like log_ring_push(), events after the end
+ * of the simulation are dropped, except for the death itself.
+ * 
+ * The caller has already ended the simulation for a death.
+ * 
+ * @param sim The simulation.
+ * @param philo_id ID of the philosopher the event belongs to.
+ * @param event One of t_log_event.
+ * @return The event's timestamp in nanoseconds.
+ */
+long long	log_direct(t_simulation *sim, int philo_id, t_log_event event)
+{
+	t_log_record	record;
+
+	record.timestamp = simulation_time(sim);
+	if (sim->logger.file.open)
+	{
+		log_file_append(&sim->logger, philo_id, event, record.timestamp);
+		return (record.timestamp);
+	}
+	if (event != LOG_DIED && is_simulation_finished(sim))
+		return (record.timestamp);
+	record.philo_id = philo_id;
+	record.event = event;
+	log_append_record(&sim->logger, &record);
+	return (record.timestamp);
+}
+
+/**
+ * @brief Trims the trace file to its reserved slots, unmaps and closes it.
+ * 
+ * Called once every producer has been joined. A file left behind by a
+ * killed process keeps its zeroed tail, where decoding stops.
+ * 
+ * @param logger The logger; nothing happens without a trace file.
+ */
+void	log_file_close(t_logger *logger)
+{
+	t_log_file	*file;
+	size_t		used;
+
+	file = &logger->file;
+	if (!file->open)
+		return ;
+	used = (atomic_load(&file->next) + 1) * sizeof(t_log_slot);
+	if (file->mapped && used < atomic_load(&file->size)
+		&& ftruncate(file->fd, used) != SUCCESS)
+		print_error("Error: Cannot trim the trace file.\n");
+	while (file->mapped > 0)
+		munmap(file->segments[--file->mapped], LOG_FILE_SEGMENT_BYTES);
+	free(file->segments);
+	file->segments = NULL;
+	pthread_mutex_destroy(&file->grow_mutex);
+	close(file->fd);
+	file->open = FALSE;
+}
@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log_merge.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:39:50 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:05:31 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Returns the timestamp of the oldest record in a heap slot's ring.
+ * 
+ * @param logger The logger whose heap is inspected.
+ * @param slot Heap slot; its ring is known to be non-empty.
+ * @return The timestamp used as the heap key.
+ */
+static long long	heap_key(t_logger *logger, int slot)
+{
+	t_log_ring	*ring;
+	size_t		tail;
+
+	ring = &logger->rings[logger->heap[slot]];
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	return (ring->records[tail & (logger->capacity - 1)].timestamp);
+}
+
+/**
+ * @brief Moves a heap entry up until its parent is not newer.
+ * 
+ * @param logger The logger whose heap is updated.
+ * @param slot Slot of the entry to move.
+ */
+static void	heap_sift_up(t_logger *logger, int slot)
+{
+	int	parent;
+	int	swap;
+
+	while (slot > 0)
+	{
+		parent = (slot - 1) / 2;
+		if (heap_key(logger, parent) <= heap_key(logger, slot))
+			break ;
+		swap = logger->heap[parent];
+		logger->heap[parent] = logger->heap[slot];
+		logger->heap[slot] = swap;
+		slot = parent;
+	}
+}
+
+/**
+ * @brief Moves a heap entry down until no child is older.
+ * 
+ * @param logger The logger whose heap is updated.
+ * @param slot Slot of the entry to move.
+ */
+static void	heap_sift_down(t_logger *logger, int slot)
+{
+	int	child;
+	int	swap;
+
+	while (2 * slot + 1 < logger->heap_size)
+	{
+		child = 2 * slot + 1;
+		if (child + 1 < logger->heap_size
+			&& heap_key(logger, child + 1) < heap_key(logger, child))
+			child++;
+		if (heap_key(logger, slot) <= heap_key(logger, child))
+			break ;
+		swap = logger->heap[child];
+		logger->heap[child] = logger->heap[slot];
+		logger->heap[slot] = swap;
+		slot = child;
+	}
+}
+
+/**
+ * @brief Emits every ready record up to `horizon` in timestamp order.
+ * 
+ * Each ring is already ordered, so this is a k-way merge: the rings with a
+ * ready record are kept in a min-heap keyed by their oldest timestamp and
+ * the top is emitted until no ring has a record within the horizon.
+ * The cost is O(log R) per record for R producer rings.
+ * 
+ * @param logger The logger to drain.
+ * @param horizon Latest timestamp that is safe to emit
+ *                (see log_safe_horizon()).
+ */
+void	log_drain(t_logger *logger, long long horizon)
+{
+	int				i;
+	t_log_record	*record;
+
+	logger->heap_size = 0;
+	i = -1;
+	while (++i < logger->ring_count)
+	{
+		if (!log_ring_front(logger, i, horizon, &record))
+			continue ;
+		logger->heap[logger->heap_size] = i;
+		heap_sift_up(logger, logger->heap_size++);
+	}
+	while (logger->heap_size > 0)
+	{
+		i = logger->heap[0];
+		log_ring_front(logger, i, horizon, &record);
+		log_append_record(logger, record);
+		log_ring_consume(logger, i);
+		if (!log_ring_front(logger, i, horizon, &record))
+			logger->heap[0] = logger->heap[--logger->heap_size];
+		heap_sift_down(logger, 0);
+	}
+}
+
+/**
+ * @brief Counts the events pushed but not yet consumed, over all rings.
+ * 
+ * Meant for monitoring from any thread: the relaxed loads may see a ring
+ * a little before or after its latest push or pop, never a torn value.
+ * 
+ * @param logger The logger.
+ * @return Number of events waiting in the rings.
+ */
+long	log_backlog(t_logger *logger)
+{
+	long	backlog;
+	int		i;
+
+	backlog = 0;
+	i = -1;
+	while (++i < logger->ring_count)
+		backlog += atomic_load_explicit(&logger->rings[i].head,
+				memory_order_relaxed) - atomic_load_explicit(
+				&logger->rings[i].tail, memory_order_relaxed);
+	return (backlog);
+}
@@ -0,0 +1,151 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log_ring.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:39:36 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:11:00 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Resets a producer ring to the empty state.
+ * 
+ * @param ring The ring to initialize.
+ * @param records Storage for the logger's `capacity` records.
+ */
+void	log_ring_init(t_log_ring *ring, t_log_record *records)
+{
+	ring->records = records;
+	atomic_init(&ring->head, 0);
+	atomic_init(&ring->tail, 0);
+	atomic_init(&ring->last_timestamp, 0);
+	atomic_init(&ring->in_flight, FALSE);
+}
+
+/**
+ * @brief Pushes one event into the producer's own ring.
+ * 
+ * The sequence is:
+ * 
+ * 1. Raise `in_flight` (sequentially consistent), then stamp `entry`, so
+ *    the writer cannot move its horizon past the timestamp. This is the
+ *    only clock reading of the event; the caller gets it back in `entry`.
+ * 2. Drop the event if the simulation has ended or the writer has closed;
+ *    otherwise wait while the ring is full (the writer keeps draining).
+ * 3. Copy the record, publish it by advancing `head` (release) and lower
+ *    `in_flight`.
+ * 
+ * Nothing is formatted and no lock is taken here.
+ * 
+ * @param logger The logger that owns the ring.
+ * @param ring The calling thread's ring.
+ * @param entry The event's `philo_id` and `event`; receives its timestamp
+ *              even if the event is dropped.
+ * @return The number of times the producer had to back off because its
+ *         ring was full (normally 0).
+ */
+int	log_ring_push(t_logger *logger, t_log_ring *ring, t_log_record *entry)
+{
+	size_t			head;
+	int				stalls;
+
+	atomic_store(&ring->in_flight, TRUE);
+	entry->timestamp = get_time_ns();
+	head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	stalls = 0;
+	while (!atomic_load_explicit(logger->halt, memory_order_acquire)
+		&& !atomic_load_explicit(&logger->closed, memory_order_acquire)
+		&& head - atomic_load_explicit(&ring->tail, memory_order_acquire)
+		>= logger->capacity && ++stalls)
+		usleep(LOG_FULL_BACKOFF_US);
+	if (!atomic_load_explicit(logger->halt, memory_order_acquire)
+		&& !atomic_load_explicit(&logger->closed, memory_order_acquire))
+	{
+		ring->records[head & (logger->capacity - 1)] = *entry;
+		atomic_store_explicit(&ring->last_timestamp, entry->timestamp,
+			memory_order_relaxed);
+		atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+	}
+	atomic_store_explicit(&ring->in_flight, FALSE, memory_order_release);
+	return (stalls);
+}
+
+/**
+ * @brief Computes the latest timestamp the writer may emit up to.
+ * 
+ * A producer that is not in flight can only publish events stamped after
+ * `now`. A producer that is in flight may be about to publish an event
+ * stamped as early as its previous record, so its `last_timestamp` caps the
+ * horizon. Every record stamped at or before the returned value is therefore
+ * already visible, and emitting them in timestamp order cannot be
+ * contradicted by a record that shows up later.
+ * 
+ * @param logger The logger to scan.
+ * @param now A clock reading taken before the call.
+ * @return The safe horizon in nanoseconds.
+ */
+long long	log_safe_horizon(t_logger *logger, long long now)
+{
+	int			i;
+	long long	horizon;
+	long long	bound;
+
+	horizon = now;
+	i = -1;
+	while (++i < logger->ring_count)
+	{
+		if (atomic_load(&logger->rings[i].in_flight))
+		{
+			bound = atomic_load_explicit(&logger->rings[i].last_timestamp,
+					memory_order_relaxed);
+			if (bound < horizon)
+				horizon = bound;
+		}
+	}
+	return (horizon);
+}
+
+/**
+ * @brief Peeks at the oldest unconsumed record of a ring.
+ * 
+ * @param logger The logger that owns the ring.
+ * @param index Index of the ring.
+ * @param horizon Records stamped after this are treated as not ready.
+ * @param record Receives a pointer to the oldest record, if any.
+ * @return TRUE (=1) if a record stamped at or before `horizon` is ready,
+ *         otherwise FALSE (=0).
+ */
+int	log_ring_front(t_logger *logger, int index,
+	long long horizon, t_log_record **record)
+{
+	t_log_ring	*ring;
+	size_t		tail;
+
+	ring = &logger->rings[index];
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	if (tail == atomic_load_explicit(&ring->head, memory_order_acquire))
+		return (FALSE);
+	*record = &ring->records[tail & (logger->capacity - 1)];
+	return ((*record)->timestamp <= horizon);
+}
+
+/**
+ * @brief Releases the oldest record of a ring back to its producer.
+ * 
+ * @param logger The logger that owns the ring.
+ * @param index Index of the ring.
+ */
+void	log_ring_consume(t_logger *logger, int index)
+{
+	t_log_ring	*ring;
+
+	ring = &logger->rings[index];
+	atomic_store_explicit(&ring->tail,
+		atomic_load_explicit(&ring->tail, memory_order_relaxed) + 1,
+		memory_order_release);
+}
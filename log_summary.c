@@ -0,0 +1,52 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log_summary.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:28:19 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:29:20 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Prints the outcome of a simulation in one line, for
+ *        `--output=summary`.
+ * 
+ * The line follows the death line, if any, as "# summary: T ms, M meals,
+ * fewest F", with `died` or `no death` at the end. Other output levels
+ * print nothing.
+ * 
+ * @param sim A simulation whose threads have been joined.
+ */
+void	log_summary(t_simulation *sim)
+{
+	long	meals;
+	int		fewest;
+	int		eaten;
+	int		i;
+
+	if (sim->options.output != OUTPUT_SUMMARY || sim->options.quiet)
+		return ;
+	meals = 0;
+	fewest = INT_MAX;
+	i = -1;
+	while (++i < sim->philosopher_count)
+	{
+		eaten = get_meals_eaten(&sim->philosophers[i]);
+		meals += eaten;
+		if (eaten < fewest)
+			fewest = eaten;
+	}
+	printf("# summary: %lld ms, %ld meals, fewest %d, ",
+		(simulation_time(sim) - sim->sim_start_time) / NS_PER_MS, meals,
+		fewest);
+	if (sim->death_latency_ns >= 0)
+		printf("died\n");
+	else
+		printf("no death\n");
+	fflush(stdout);
+}
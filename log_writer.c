@@ -0,0 +1,96 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log_writer.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:40:08 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 17:43:15 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Parks the writer until the next drain is due.
+ * 
+ * The writer sleeps for LOG_FLUSH_INTERVAL_US between drains, which is what
+ * turns individual events into large write(2) batches. A posted death or a
+ * stop request wakes it up immediately.
+ * 
+ * @param logger The logger whose writer is waiting.
+ */
+static void	writer_wait(t_logger *logger)
+{
+	struct timespec	deadline;
+
+	ns_to_timespec(get_time_ns() + LOG_FLUSH_INTERVAL_US * NS_PER_US,
+		&deadline);
+	pthread_mutex_lock(&logger->wake_mutex);
+	if (!atomic_load(&logger->death_posted) && !atomic_load(&logger->stop))
+		pthread_cond_timedwait(&logger->wake_cond, &logger->wake_mutex,
+			&deadline);
+	pthread_mutex_unlock(&logger->wake_mutex);
+}
+
+/**
+ * @brief Emits everything that happened before the death, then the death.
+ * 
+ * Producers stop publishing once the simulation is flagged as ended, but a
+ * few may still be in flight. The writer keeps draining until no in-flight
+ * producer can publish anything stamped before the death, emits the death
+ * line and closes the logger, so nothing is ever printed after it.
+ * 
+ * @param logger The logger that received the death record.
+ */
+static void	writer_finish_with_death(t_logger *logger)
+{
+	long long	death_time;
+	long long	horizon;
+
+	death_time = logger->death.timestamp;
+	horizon = log_safe_horizon(logger, death_time);
+	while (horizon < death_time)
+	{
+		log_drain(logger, horizon);
+		usleep(LOG_FULL_BACKOFF_US);
+		horizon = log_safe_horizon(logger, death_time);
+	}
+	log_drain(logger, death_time);
+	log_append_record(logger, &logger->death);
+	log_flush(logger);
+	atomic_store_explicit(&logger->closed, TRUE, memory_order_release);
+}
+
+/**
+ * @brief Main loop of the writer thread.
+ * 
+ * Repeatedly drains all rings up to the safe horizon and flushes the batch,
+ * until either a death is posted or a stop is requested. On stop every
+ * producer has already been joined, so the rings are drained completely.
+ * 
+ * @param arg Pointer to the t_logger.
+ * @return NULL on thread completion.
+ */
+void	*log_writer_routine(void *arg)
+{
+	t_logger	*logger;
+
+	logger = (t_logger *)arg;
+	while (!atomic_load(&logger->death_posted) && !atomic_load(&logger->stop))
+	{
+		log_drain(logger, log_safe_horizon(logger, get_time_ns()));
+		log_flush(logger);
+		writer_wait(logger);
+	}
+	if (atomic_load(&logger->death_posted))
+		writer_finish_with_death(logger);
+	else
+	{
+		log_drain(logger, LLONG_MAX);
+		log_flush(logger);
+		atomic_store_explicit(&logger->closed, TRUE, memory_order_release);
+	}
+	return (NULL);
+}
@@ -6,43 +6,30 @@
 /*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/06/28 22:52:51 by hoskim            #+#    #+#             */
-/*   Updated: 2025/07/16 00:11:53 by hoskim           ###   ########seoul.kr  */
+/*   Updated: 2026/10/14 19:27:08 by hoskim           ###   ########seoul.kr  */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
 /**
- * @brief Launches all philosopher threads and sets the simulation start time.
- * 
- * This function initializes the simulation by recording the start time.
- * It then iterates through each philsopher,
- * setting their initial `last_meal_time` to the simulation's start time.
- * A new thread is created for each philosopher, which will execute
- * the `philosopher_lifecycle` function.
- * 
- * @param sim A pointer to the simulation structure,
- *            containing all simulation data.
- * @return Returns `SUCCESS` if all threads are created successfully. Otherwise,
- *         it prints an error message and returns an error code.
+ * @brief Runs the mode chosen instead of a single simulation.
  * 
+ * @param options The parsed options; `--bench`, `--sweep`, `--perf` or
+ *                `--batch`.
+ * @param argc The count of positional arguments, plus one for argv[0].
+ * @param argv The positional arguments, starting at argv[1].
+ * @return The exit status of the mode.
  */
-static int	launch_philosopher_threads(t_simulation *sim)
+static int	run_mode(const t_options *options, int argc, char *argv[])
 {
-	int	i;
-
-	i = 0;
-	sim->sim_start_time = get_current_time_ms();
-	while (i < sim->philosopher_count)
-	{
-		sim->philosophers[i].last_meal_time = sim->sim_start_time;
-		if (pthread_create(&sim->philosophers[i].thread, NULL, \
-				philosopher_lifecycle, &sim->philosophers[i]) != SUCCESS)
-			return (
-				print_error("Error: Failed to create philosopher thread.\n"));
-		i++;
-	}
-	return (SUCCESS);
+	if (options->bench)
+		return (run_benchmark(options));
+	if (options->sweep)
+		return (run_sweep(options, argc, argv));
+	if (options->perf)
+		return (run_perf(options));
+	return (run_batch(options));
 }
 
 /**
@@ -50,10 +37,16 @@ static int	launch_philosopher_threads(t_simulation *sim)
  * 
  * This function orchestrates the entire simulation.
  * It performs the following steps:
- * 1. Initializes the simulation state, including philosophers, forks, and rules,
+ * 1. Parses the leading `--options`; `--bench` runs the benchmark matrix,
+ *    `--sweep` a parameter sweep, `--perf` the regression suite and
+ *    `--batch` one simulation per input line instead of a single
+ *    simulation.
+ * 2. Initializes the simulation state, including philosophers, forks, and rules,
  *    based on the command-line arguments provided.
- * 2. Launches the threads for each philosopher, starting their lifecycles.
- * 3. Enters a monitoring loop that checks the state of the simulation
+ * 3. Launches the threads for each philosopher, starting their lifecycles.
+ *    If setup or launch fails, the threads already started are stopped and
+ *    joined and everything set up so far is released.
+ * 4. Enters a monitoring loop that checks the state of the simulation
  *    (e.g., for philosopher deaths or completion of the simulation) and performs
  *    the final cleanup of resources.
  * 
@@ -65,13 +58,23 @@ static int	launch_philosopher_threads(t_simulation *sim)
 int	main(int argc, char *argv[])
 {
 	t_simulation	simulation;
+	t_options		options;
+	int				first;
 
-	if (initialize_simulation(&simulation, argc, argv) != SUCCESS)
+	first = parse_options(&options, argc, argv);
+	if (first < 0)
+		return (FAILURE);
+	if (options.bench || options.sweep || options.batch_path || options.perf)
+		return (run_mode(&options, argc - first + 1, argv + first - 1));
+	if (initialize_simulation(&simulation, &options,
+			argc - first + 1, argv + first - 1) != SUCCESS)
+	{
+		release_simulation_resources(&simulation);
 		return (FAILURE);
+	}
 	if (launch_philosopher_threads(&simulation) != SUCCESS)
 	{
-		free(simulation.philosophers);
-		free(simulation.fork_mutexes);
+		abort_simulation(&simulation);
 		return (FAILURE);
 	}
 	monitor_simulation_and_cleanup(&simulation);
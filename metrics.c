@@ -0,0 +1,108 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   metrics.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:03:49 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:05:31 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Takes a snapshot and rewrites the metrics file with it.
+ * 
+ * A failed write is not fatal: the simulation goes on and the next
+ * snapshot tries again.
+ * 
+ * @param sim The simulation.
+ */
+static void	metrics_publish(t_simulation *sim)
+{
+	t_metrics_sample	sample;
+
+	metrics_sample(sim, &sample);
+	metrics_write(sim, &sample);
+}
+
+/**
+ * @brief Body of the metrics thread: one snapshot per interval.
+ * 
+ * Sleeps on `simulation_ended` with an absolute deadline, so it never
+ * touches the philosophers' or the monitor's locks and still wakes up as
+ * soon as the simulation ends, to write the final snapshot while it
+ * shows the end state (philosophers may still finish a meal after it).
+ * 
+ * @param arg The simulation.
+ * @return NULL.
+ */
+static void	*metrics_routine(void *arg)
+{
+	t_simulation	*sim;
+	long long		interval;
+	long long		deadline;
+
+	sim = (t_simulation *)arg;
+	start_gate_wait(sim);
+	interval = ms_to_ns(sim->options.metrics_interval_ms);
+	if (interval == 0)
+		interval = ms_to_ns(METRICS_INTERVAL_MS);
+	deadline = sim->sim_start_time + interval;
+	while (!atomic_load(&sim->simulation_ended))
+	{
+		futex_wait_until(&sim->simulation_ended, FALSE, deadline);
+		if (get_time_ns() < deadline)
+			continue ;
+		metrics_publish(sim);
+		deadline += interval;
+	}
+	metrics_publish(sim);
+	return (NULL);
+}
+
+/**
+ * @brief Starts the `--metrics` thread, if the option was given.
+ * 
+ * Called once the start time is set, before the start gate opens. Quiet
+ * benchmark and sweep runs, many at a time, export nothing. The
+ * virtual engine runs on the calling thread without a wall-clock pace,
+ * so it gets no thread, only the final snapshot of metrics_stop().
+ * 
+ * @param sim The simulation.
+ * @return SUCCESS (=0), or FAILURE (=1) after printing an error.
+ */
+int	metrics_start(t_simulation *sim)
+{
+	if (!sim->options.metrics_path || sim->options.quiet)
+		return (SUCCESS);
+	sim->metrics.active = TRUE;
+	sim->metrics.last_time = sim->sim_start_time;
+	sim->metrics.last_meals = 0;
+	if (sim->options.engine == ENGINE_VIRTUAL)
+		return (SUCCESS);
+	if (pthread_create(&sim->metrics.thread, NULL, metrics_routine, sim) != 0)
+		return (print_error("Error: Failed to create the metrics thread.\n"));
+	sim->metrics.running = TRUE;
+	return (SUCCESS);
+}
+
+/**
+ * @brief Joins the metrics thread, which has written the final snapshot.
+ * 
+ * Under the virtual engine, which has no metrics thread, the final
+ * snapshot is written here instead, once the run is over.
+ * 
+ * @param sim A simulation that has ended.
+ */
+void	metrics_stop(t_simulation *sim)
+{
+	if (sim->metrics.running)
+		pthread_join(sim->metrics.thread, NULL);
+	else if (sim->metrics.active)
+		metrics_publish(sim);
+	sim->metrics.running = FALSE;
+	sim->metrics.active = FALSE;
+}
@@ -0,0 +1,150 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   metrics_sample.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:03:40 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:05:31 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+#include <fcntl.h> // open()
+
+/**
+ * @brief Takes a snapshot of a running simulation without stopping it.
+ * 
+ * Every field is read with a relaxed load of the atomics the philosophers
+ * and the log writer already publish, so nothing on their side changes and
+ * no lock is taken. The snapshot is therefore not one instant, but each
+ * value is one that really occurred. Philosophers who have eaten enough
+ * do not count towards the worst slack. Fork waits are counted on the
+ * fork's lock by both engines: the thread engine when a ticket is not
+ * served at once, the pool engine when a task queues behind the holder.
+ * 
+ * @param sim The simulation.
+ * @param sample Receives the snapshot.
+ */
+void	metrics_sample(t_simulation *sim, t_metrics_sample *sample)
+{
+	long long	slack;
+	int			meals;
+	int			i;
+
+	memset(sample, 0, sizeof(t_metrics_sample));
+	sample->now = simulation_time(sim);
+	sample->worst_slack = ms_to_ns(sim->time_to_die);
+	i = -1;
+	while (++i < sim->philosopher_count)
+	{
+		meals = atomic_load_explicit(&sim->seats[i].meals_eaten,
+				memory_order_relaxed);
+		sample->meals += meals;
+		slack = atomic_load_explicit(&sim->seats[i].last_meal_time,
+				memory_order_relaxed) - sample->now;
+		slack += ms_to_ns(sim->time_to_die);
+		if (slack < sample->worst_slack
+			&& (sim->required_meals < 0 || meals < sim->required_meals))
+			sample->worst_slack = slack;
+		sample->fork_waits += atomic_load_explicit(&sim->seats[i].fork.waits,
+				memory_order_relaxed);
+	}
+	sample->backlog = log_backlog(&sim->logger);
+}
+
+/**
+ * @brief Returns the metrics of a snapshot, in output order.
+ * 
+ * @return A pointer to the METRICS_COUNT entries of the static table.
+ */
+static const t_metric_spec	*metric_table(void)
+{
+	static const t_metric_spec	table[METRICS_COUNT] = {
+	{"philo_elapsed_seconds", "gauge", "Simulated time so far."},
+	{"philo_meals_total", "counter", "Meals eaten by all philosophers."},
+	{"philo_meals_per_second", "gauge",
+		"Meal rate since the last snapshot, over the whole run at the end."},
+	{"philo_worst_slack_seconds", "gauge", "Least time left before a death."},
+	{"philo_fork_waits_total", "counter",
+		"Fork acquires that had to wait for the holder."},
+	{"philo_log_backlog", "gauge", "Events waiting in the log rings."},
+	{"philo_simulation_ended", "gauge", "1 once the simulation has ended."}
+	};
+
+	return (table);
+}
+
+/**
+ * @brief Converts a snapshot to the values of metric_table().
+ * 
+ * The meal rate is measured since the previous snapshot. The final
+ * snapshot follows the end at once, usually a fraction of an interval
+ * after the previous one, so its rate is taken over the whole run
+ * instead.
+ * 
+ * @param sim The simulation.
+ * @param sample The snapshot.
+ * @param values Receives METRICS_COUNT values.
+ */
+static void	metric_values(t_simulation *sim, const t_metrics_sample *sample,
+	double *values)
+{
+	long long	interval;
+	long		meals;
+
+	interval = sample->now - sim->metrics.last_time;
+	meals = sample->meals - sim->metrics.last_meals;
+	if (atomic_load(&sim->simulation_ended))
+	{
+		interval = sample->now - sim->sim_start_time;
+		meals = sample->meals;
+	}
+	if (interval < 1)
+		interval = 1;
+	values[0] = (double)(sample->now - sim->sim_start_time) / NS_PER_SEC;
+	values[1] = sample->meals;
+	values[2] = (double)meals * NS_PER_SEC / interval;
+	values[3] = (double)sample->worst_slack / NS_PER_SEC;
+	values[4] = sample->fork_waits;
+	values[5] = sample->backlog;
+	values[6] = atomic_load(&sim->simulation_ended);
+}
+
+/**
+ * @brief Replaces the `--metrics` file with one snapshot.
+ * 
+ * The snapshot is written in the Prometheus text exposition format to a
+ * file next to the final one, which is then renamed over it, so a scraper
+ * (e.g. node_exporter's textfile collector) never reads half of one.
+ * 
+ * @param sim The simulation.
+ * @param sample The snapshot.
+ * @return SUCCESS (=0), or FAILURE (=1) if the file could not be written.
+ */
+int	metrics_write(t_simulation *sim, const t_metrics_sample *sample)
+{
+	const t_metric_spec	*spec;
+	double				values[METRICS_COUNT];
+	char				temp[PATH_MAX];
+	int					fd;
+	int					i;
+
+	spec = metric_table();
+	metric_values(sim, sample, values);
+	sim->metrics.last_meals = sample->meals;
+	sim->metrics.last_time = sample->now;
+	snprintf(temp, sizeof(temp), "%s.tmp", sim->options.metrics_path);
+	fd = open(temp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return (FAILURE);
+	i = -1;
+	while (++i < METRICS_COUNT)
+		dprintf(fd, "# HELP %s %s\n# TYPE %s %s\n%s %.9g\n", spec[i].name,
+			spec[i].help, spec[i].name, spec[i].type, spec[i].name, values[i]);
+	close(fd);
+	if (rename(temp, sim->options.metrics_path) != 0)
+		return (FAILURE);
+	return (SUCCESS);
+}
@@ -0,0 +1,175 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   monitor.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:42:03 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:13:35 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Wakes the monitor before its current deadline.
+ * 
+ * Called by the last philosopher to reach `required_meals`, so the monitor
+ * can end the simulation right away instead of sleeping until the next
+ * death deadline, and by a pool worker or monitor shard that reported a
+ * death.
+ * 
+ * @param sim A pointer to the main simulation structure.
+ */
+void	notify_monitor(t_simulation *sim)
+{
+	pthread_mutex_lock(&sim->monitor_mutex);
+	pthread_cond_signal(&sim->monitor_cond);
+	pthread_mutex_unlock(&sim->monitor_mutex);
+}
+
+/**
+ * @brief Sleeps until the given absolute deadline or until notified.
+ * 
+ * `monitor_cond` is bound to CLOCK_MONOTONIC, the same time base as
+ * get_time_ns(), so the deadline is passed through unchanged.
+ * 
+ * @param sim A pointer to the main simulation structure.
+ * @param deadline Absolute wake-up time in nanoseconds.
+ */
+static void	monitor_wait_until(t_simulation *sim, long long deadline)
+{
+	struct timespec	wake_time;
+
+	if (deadline > sim->stop_time)
+		deadline = sim->stop_time;
+	ns_to_timespec(deadline, &wake_time);
+	pthread_mutex_lock(&sim->monitor_mutex);
+	if (atomic_load(&sim->satisfied_count) < sim->philosopher_count
+		&& !is_simulation_finished(sim))
+		pthread_cond_timedwait(&sim->monitor_cond, &sim->monitor_mutex,
+			&wake_time);
+	pthread_mutex_unlock(&sim->monitor_mutex);
+}
+
+/**
+ * @brief Checks the philosopher of a shard whose death deadline comes first.
+ * 
+ * The heap top is the earliest known deadline. If that philosopher has eaten
+ * since it was recorded, the deadline is refreshed in O(log N). If it is
+ * current and has passed, the philosopher has starved. Otherwise the monitor
+ * sleeps exactly until it (or until the time limit, if that comes first):
+ * a lone shard on `monitor_cond`, so a satisfied run wakes it, and a shard
+ * thread on `simulation_ended`, which the main thread sets for any other
+ * end condition.
+ * 
+ * @param shard The shard to check.
+ * @return Returns the ID of the philosopher who died.
+ *         If no one has died, it returns NOT_DEAD (=0).
+ */
+int	check_for_death(t_monitor_shard *shard)
+{
+	t_simulation	*sim;
+	t_deadline		*top;
+	long long		deadline;
+
+	sim = shard->simulation;
+	top = &shard->heap.entries[0];
+	deadline = get_last_meal_time(&sim->philosophers[top->index])
+		+ ms_to_ns(sim->time_to_die);
+	if (deadline > top->deadline)
+	{
+		deadline_heap_update_top(&shard->heap, deadline);
+		return (NOT_DEAD);
+	}
+	shard->death_time = get_time_ns();
+	if (shard->death_time >= deadline)
+	{
+		shard->death_latency_ns = shard->death_time - deadline;
+		return (top->index + 1);
+	}
+	if (sim->shard_count == 1)
+		monitor_wait_until(sim, deadline);
+	else
+		futex_wait_until(&sim->simulation_ended, FALSE, deadline);
+	return (NOT_DEAD);
+}
+
+/**
+ * @brief Evaluates the overall status of the simulation to check for
+ *        end conditions.
+ * 
+ * It checks for the two possible end conditions in order:
+ * 
+ * 1. All philosophers have eaten the required number of meals, which is a
+ *    single atomic counter maintained by record_meal(), or the time limit
+ *    of a benchmark run has passed.
+ * 2. A philosopher has died.
+ * 
+ * If a death is detected, it prints the status message and signals to end
+ * the simulation. With `--engine=pool` deaths are timers of the workers
+ * (see task_starve()), and with several `--monitors` shards each shard
+ * thread watches its own philosophers, so the monitor only waits for the
+ * other two.
+ * 
+ * @param sim A pointer to the main simulation structure.
+ * @return Returns TRUE (=1) if the simulation has ended (either by death or
+ *         satisfaction), otherwise returns FALSE (=0).
+ */
+static int	evaluate_simulation_status(t_simulation *sim)
+{
+	int	dead_philosopher_id;
+
+	if (atomic_load(&sim->satisfied_count) >= sim->philosopher_count
+		|| get_time_ns() >= sim->stop_time)
+	{
+		end_simulation(sim);
+		return (TRUE);
+	}
+	if (sim->options.engine == ENGINE_POOL || sim->shard_count > 1)
+	{
+		monitor_wait_until(sim, get_time_ns() + POOL_IDLE_WAIT_NS);
+		return (is_simulation_finished(sim));
+	}
+	dead_philosopher_id = check_for_death(&sim->shards[0]);
+	if (dead_philosopher_id > 0)
+	{
+		shard_report_death(&sim->shards[0], dead_philosopher_id);
+		return (TRUE);
+	}
+	return (FALSE);
+}
+
+/**
+ * @brief Runs the monitor until the simulation ends.
+ * 
+ * Instead of polling every philosopher at a fixed interval, the monitor
+ * keeps a min-heap of death deadlines (`last_meal_time + time_to_die`) and
+ * sleeps until the earliest one. Each wake-up costs O(log N), and a death is
+ * detected as soon as its deadline passes. Past MONITOR_SHARD_SIZE
+ * philosophers (or with `--monitors=N`) the heap is split into shards that
+ * each run on a thread of their own (see monitor_shards_start()).
+ * 
+ * @param sim A pointer to the main simulation structure.
+ */
+void	monitor_simulation(t_simulation *sim)
+{
+	sim->stop_time = LLONG_MAX;
+	if (sim->time_limit_ms > 0)
+		sim->stop_time = sim->sim_start_time + ms_to_ns(sim->time_limit_ms);
+	if (sim->options.engine == ENGINE_VIRTUAL)
+	{
+		virtual_run(sim);
+		return ;
+	}
+	if (sim->shard_count == 1)
+		deadline_heap_build(&sim->shards[0].heap, sim, 0);
+	else if (sim->shard_count > 1 && monitor_shards_start(sim) != SUCCESS)
+		end_simulation(sim);
+	while (TRUE)
+	{
+		if (evaluate_simulation_status(sim) == TRUE)
+			break ;
+	}
+}
@@ -0,0 +1,155 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   monitor_shard.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:12:30 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:13:35 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Returns how many death monitor shards a simulation uses.
+ * 
+ * One per MONITOR_SHARD_SIZE philosophers unless `--monitors=N` says
+ * otherwise, and never more than there are philosophers. Only the thread
+ * engine has a monitor heap; the pool engine's workers watch their own
+ * tasks' deadlines.
+ * 
+ * @param sim A configured simulation.
+ * @return The number of shards, 0 with `--engine=pool|virtual`.
+ */
+int	monitor_shard_count(t_simulation *sim)
+{
+	int	count;
+
+	if (sim->options.engine != ENGINE_THREADS)
+		return (0);
+	count = sim->options.monitors;
+	if (count == 0)
+		count = (sim->philosopher_count + MONITOR_SHARD_SIZE - 1)
+			/ MONITOR_SHARD_SIZE;
+	if (count > MONITORS_MAX)
+		count = MONITORS_MAX;
+	if (count > sim->philosopher_count)
+		count = sim->philosopher_count;
+	return (count);
+}
+
+/**
+ * @brief Carves the shards out of the arena and splits the philosophers
+ *        among them in contiguous ranges.
+ * 
+ * Each shard's heap is its own slice of `deadlines`, so the shards share
+ * no heap state and need no lock.
+ * 
+ * @param sim A simulation whose deadline storage is allocated.
+ * @return SUCCESS (=0), or FAILURE (=1) after printing an error.
+ */
+int	monitor_shards_init(t_simulation *sim)
+{
+	t_monitor_shard	*shard;
+	int				k;
+	int				end;
+
+	sim->shard_count = monitor_shard_count(sim);
+	if (sim->shard_count == 0)
+		return (SUCCESS);
+	sim->shards = arena_alloc(&sim->arena,
+			sizeof(t_monitor_shard) * sim->shard_count);
+	if (!sim->shards)
+		return (print_error("Error: Memory allocation failed\n"));
+	k = -1;
+	while (++k < sim->shard_count)
+	{
+		shard = &sim->shards[k];
+		shard->first = (long long)sim->philosopher_count * k
+			/ sim->shard_count;
+		end = (long long)sim->philosopher_count * (k + 1) / sim->shard_count;
+		shard->heap.entries = sim->deadlines.entries + shard->first;
+		shard->heap.size = end - shard->first;
+		shard->simulation = sim;
+		shard->started = FALSE;
+	}
+	return (SUCCESS);
+}
+
+/**
+ * @brief Reports a death found by a shard, unless the simulation already
+ *        ended.
+ * 
+ * end_simulation() is the arbitration: of several shards that find a
+ * death at the same time, only the one whose exchange ended the simulation
+ * prints, so exactly one "died" line appears and the recorded latency is
+ * that death's.
+ * 
+ * @param shard The shard that found the death.
+ * @param dead_id ID of the philosopher who died.
+ * @return TRUE (=1) if this death was reported, FALSE (=0) if the
+ *         simulation had already ended.
+ */
+int	shard_report_death(t_monitor_shard *shard, int dead_id)
+{
+	t_simulation	*sim;
+
+	sim = shard->simulation;
+	if (!end_simulation(sim))
+		return (FALSE);
+	sim->death_latency_ns = shard->death_latency_ns;
+	sim->death_time = shard->death_time;
+	log_philo_status(&sim->philosophers[dead_id - 1], LOG_DIED);
+	notify_monitor(sim);
+	return (TRUE);
+}
+
+/**
+ * @brief Body of a shard thread: the monitor loop over its own heap.
+ * 
+ * @param arg The shard.
+ * @return NULL once the simulation has ended.
+ */
+static void	*shard_routine(void *arg)
+{
+	t_monitor_shard	*shard;
+	int				dead_id;
+
+	shard = (t_monitor_shard *)arg;
+	deadline_heap_build(&shard->heap, shard->simulation, shard->first);
+	while (!is_simulation_finished(shard->simulation))
+	{
+		dead_id = check_for_death(shard);
+		if (dead_id > 0)
+			shard_report_death(shard, dead_id);
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Starts one monitor thread per shard.
+ * 
+ * Called by the main thread once the simulation runs, so every deadline
+ * the shards read is already based on the start time. The threads are
+ * joined by join_simulation_threads().
+ * 
+ * @param sim A running simulation with more than one shard.
+ * @return SUCCESS (=0), or FAILURE (=1) after printing an error; the
+ *         caller then ends the simulation.
+ */
+int	monitor_shards_start(t_simulation *sim)
+{
+	int	k;
+
+	k = -1;
+	while (++k < sim->shard_count)
+	{
+		if (pthread_create(&sim->shards[k].thread, NULL, shard_routine,
+				&sim->shards[k]) != 0)
+			return (print_error("Error: Failed to create monitor thread.\n"));
+		sim->shards[k].started = TRUE;
+	}
+	return (SUCCESS);
+}
@@ -0,0 +1,521 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:45:11 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:29:20 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Handles `--bench`.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) if a value was given.
+ */
+static int	option_bench(t_options *options, const char *value)
+{
+	if (value)
+		return (FAILURE);
+	options->bench = TRUE;
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--sweep`: the positional arguments are ranges.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) if a value was given.
+ */
+static int	option_sweep(t_options *options, const char *value)
+{
+	if (value)
+		return (FAILURE);
+	options->sweep = TRUE;
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--perf[=BASELINE]`: run the perf suite, and compare it
+ *        with the BASELINE file if one is given.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) for an empty path.
+ */
+static int	option_perf(t_options *options, const char *value)
+{
+	if (value && !*value)
+		return (FAILURE);
+	options->perf = TRUE;
+	options->perf_baseline = value;
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--runs=N`, how many times `--perf` runs each case.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) unless 1 <= N <= PERF_MAX_RUNS.
+ */
+static int	option_runs(t_options *options, const char *value)
+{
+	if (!value || *value < '0' || *value > '9' || ft_atoi(value) < 1
+		|| ft_atoi(value) > PERF_MAX_RUNS)
+		return (FAILURE);
+	options->perf_runs = ft_atoi(value);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--stats=table|json`, the format of the PHILO_STATS dump.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) for an unknown format.
+ */
+static int	option_stats(t_options *options, const char *value)
+{
+	if (value && strcmp(value, "table") == 0)
+		options->stats_format = STATS_TABLE;
+	else if (value && strcmp(value, "json") == 0)
+		options->stats_format = STATS_JSON;
+	else
+		return (FAILURE);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--trace=text|binary`, the format of the event output.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) for an unknown format.
+ */
+static int	option_trace(t_options *options, const char *value)
+{
+	if (value && strcmp(value, "text") == 0)
+		options->trace_format = LOG_FORMAT_TEXT;
+	else if (value && strcmp(value, "binary") == 0)
+		options->trace_format = LOG_FORMAT_BINARY;
+	else
+		return (FAILURE);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--batch[=PATH]`: run one configuration per line of PATH,
+ *        or of the standard input without a value or with `-`.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) for an empty path.
+ */
+static int	option_batch(t_options *options, const char *value)
+{
+	if (value && !*value)
+		return (FAILURE);
+	options->batch_path = "-";
+	if (value)
+		options->batch_path = value;
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--output=full|state|summary`, which events are logged.
+ * 
+ * `state` drops the fork pickups, `summary` every event but deaths, and
+ * adds a summary line at the end.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) for an unknown level.
+ */
+static int	option_output(t_options *options, const char *value)
+{
+	if (value && strcmp(value, "full") == 0)
+		options->output = OUTPUT_FULL;
+	else if (value && strcmp(value, "state") == 0)
+		options->output = OUTPUT_STATE;
+	else if (value && strcmp(value, "summary") == 0)
+		options->output = OUTPUT_SUMMARY;
+	else
+		return (FAILURE);
+	options->muted_events = 0;
+	if (options->output == OUTPUT_STATE)
+		options->muted_events = LOG_FORK_EVENTS;
+	if (options->output == OUTPUT_SUMMARY)
+		options->muted_events = ~(1U << LOG_DIED);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--think=adaptive|fixed`, how long philosophers think.
+ * 
+ * `adaptive` yields the forks to a needier neighbour for as long as the
+ * philosopher's slack allows (adaptive_think(), task_think() on the pool
+ * and virtual engines); `fixed` keeps the start stagger and the fixed
+ * thinking delay. Neighbours are only known on the ring: on any other
+ * `--topology`, adaptive philosophers never yield and get hungry as soon
+ * as they think.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) for an unknown mode.
+ */
+static int	option_think(t_options *options, const char *value)
+{
+	if (value && strcmp(value, "adaptive") == 0)
+		options->think = THINK_ADAPTIVE;
+	else if (value && strcmp(value, "fixed") == 0)
+		options->think = THINK_FIXED;
+	else
+		return (FAILURE);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--trace-file=PATH`: events go into a memory-mapped file.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) without a path.
+ */
+static int	option_trace_file(t_options *options, const char *value)
+{
+	if (!value || !*value)
+		return (FAILURE);
+	options->trace_path = value;
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--metrics=PATH`: a Prometheus text file rewritten with
+ *        live metrics every `--metrics-interval`.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) if no path was given.
+ */
+static int	option_metrics(t_options *options, const char *value)
+{
+	if (!value || !*value || strlen(value) + 5 > PATH_MAX)
+		return (FAILURE);
+	options->metrics_path = value;
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--metrics-interval=MS`, the time between two snapshots.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) unless it is a positive number.
+ */
+static int	option_metrics_interval(t_options *options, const char *value)
+{
+	if (!value || *value < '0' || *value > '9' || ft_atoi(value) <= 0)
+		return (FAILURE);
+	options->metrics_interval_ms = ft_atoi(value);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--monitors=N`: split the thread engine's death monitor
+ *        into N shards, each on its own thread.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) outside 1..MONITORS_MAX.
+ */
+static int	option_monitors(t_options *options, const char *value)
+{
+	if (!value || *value < '0' || *value > '9' || ft_atoi(value) < 1
+		|| ft_atoi(value) > MONITORS_MAX)
+		return (FAILURE);
+	options->monitors = ft_atoi(value);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--engine=threads|pool|virtual`.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) for an unknown engine.
+ */
+static int	option_engine(t_options *options, const char *value)
+{
+	if (value && strcmp(value, "threads") == 0)
+		options->engine = ENGINE_THREADS;
+	else if (value && strcmp(value, "pool") == 0)
+		options->engine = ENGINE_POOL;
+	else if (value && strcmp(value, "virtual") == 0)
+		options->engine = ENGINE_VIRTUAL;
+	else
+		return (FAILURE);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--workers=N`, the pool size of `--engine=pool`.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) unless N is a positive number.
+ */
+static int	option_workers(t_options *options, const char *value)
+{
+	if (!value || *value < '0' || *value > '9' || ft_atoi(value) < 1)
+		return (FAILURE);
+	options->workers = ft_atoi(value);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--launchers=N`: philosopher threads are created by N
+ *        threads in parallel.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) unless 1 <= N <= LAUNCHERS_MAX.
+ */
+static int	option_launchers(t_options *options, const char *value)
+{
+	if (!value || *value < '0' || *value > '9' || ft_atoi(value) < 1
+		|| ft_atoi(value) > LAUNCHERS_MAX)
+		return (FAILURE);
+	options->launchers = ft_atoi(value);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--pin`: one CPU per thread, ring ranges kept per node.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) if a value was given.
+ */
+static int	option_pin(t_options *options, const char *value)
+{
+	if (value)
+		return (FAILURE);
+	options->pin = TRUE;
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--stack-size=KB`: thread stacks of KB kibibytes, carved
+ *        from the simulation's arena.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) below PTHREAD_STACK_MIN.
+ */
+static int	option_stack_size(t_options *options, const char *value)
+{
+	if (!value || *value < '0' || *value > '9'
+		|| ft_atoi(value) < PTHREAD_STACK_MIN / 1024)
+		return (FAILURE);
+	options->stack_kb = ft_atoi(value);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Handles `--strategy=NAME`, the fork strategy of the thread engine.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) for an unknown strategy.
+ */
+static int	option_strategy(t_options *options, const char *value)
+{
+	if (!value || fork_strategy_find(value) < 0)
+		return (FAILURE);
+	options->fork_strategy = fork_strategy_find(value);
+	options->strategy_set = TRUE;
+	return (SUCCESS);
+}
+
+/**
+ * @brief Matches the kind at the start of a `--topology` value.
+ * 
+ * @param spec Receives the kind.
+ * @param value The option's value, or NULL if there was none.
+ * @return What follows the kind's name, or NULL for an unknown kind.
+ */
+static const char	*topology_kind(t_topology_spec *spec, const char *value)
+{
+	static const char	*names[] = {"ring", "grid:", "torus:", "random:",
+		"file:", NULL};
+	int					i;
+
+	if (!value)
+		return (NULL);
+	i = 0;
+	while (names[i] && strncmp(value, names[i], strlen(names[i])) != 0)
+		i++;
+	if (!names[i])
+		return (NULL);
+	spec->kind = i;
+	return (value + strlen(names[i]));
+}
+
+/**
+ * @brief Handles `--topology=ring|grid:W|torus:W|random:K[:SEED]|file:PATH`,
+ *        which forks each philosopher needs.
+ * 
+ * A grid or torus is W philosophers wide, with a fork on every edge; in a
+ * random topology each philosopher needs K forks; a file lists the forks
+ * of one philosopher per line.
+ * 
+ * @param options The options being filled in.
+ * @param value Text after '=', or NULL if there was none.
+ * @return SUCCESS (=0), or FAILURE (=1) for a malformed topology.
+ */
+static int	option_topology(t_options *options, const char *value)
+{
+	t_topology_spec	*spec;
+	const char		*rest;
+
+	spec = &options->topology;
+	memset(spec, 0, sizeof(t_topology_spec));
+	rest = topology_kind(spec, value);
+	if (!rest || (spec->kind == TOPOLOGY_RING && *rest)
+		|| (spec->kind == TOPOLOGY_FILE && !*rest))
+		return (FAILURE);
+	if (spec->kind == TOPOLOGY_FILE)
+		spec->path = rest;
+	if (spec->kind == TOPOLOGY_RING || spec->kind == TOPOLOGY_FILE)
+		return (SUCCESS);
+	spec->param = ft_atoi(rest);
+	while (*rest >= '0' && *rest <= '9')
+		rest++;
+	if (spec->kind == TOPOLOGY_RANDOM && *rest == ':' && rest[1] >= '0'
+		&& rest[1] <= '9')
+		spec->seed = ft_atoi(++rest);
+	while (*rest >= '0' && *rest <= '9')
+		rest++;
+	if (*rest || spec->param < 1)
+		return (FAILURE);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Returns the table of recognized options.
+ * 
+ * Each entry maps a `--name` to the handler that validates and stores its
+ * value. The table ends with a NULL name.
+ * 
+ * @return A pointer to the first entry of the static table.
+ */
+static const t_option_spec	*option_table(void)
+{
+	static const t_option_spec	table[] = {
+	{"--bench", option_bench},
+	{"--sweep", option_sweep},
+	{"--batch", option_batch},
+	{"--perf", option_perf},
+	{"--runs", option_runs},
+	{"--stats", option_stats},
+	{"--trace", option_trace},
+	{"--trace-file", option_trace_file},
+	{"--output", option_output},
+	{"--metrics", option_metrics},
+	{"--metrics-interval", option_metrics_interval},
+	{"--engine", option_engine},
+	{"--workers", option_workers},
+	{"--strategy", option_strategy},
+	{"--think", option_think},
+	{"--pin", option_pin},
+	{"--launchers", option_launchers},
+	{"--monitors", option_monitors},
+	{"--topology", option_topology},
+	{"--stack-size", option_stack_size},
+	{NULL, NULL}
+	};
+
+	return (table);
+}
+
+/**
+ * @brief Reports an unknown or malformed option.
+ * 
+ * @param arg The offending command-line argument.
+ * @return FAILURE indicating the error condition (=1)
+ */
+static int	option_error(const char *arg)
+{
+	print_error("Error: Invalid option: ");
+	print_error((char *)arg);
+	return (print_error("\n"));
+}
+
+/**
+ * @brief Applies one `--name` or `--name=value` argument.
+ * 
+ * @param options The options being filled in.
+ * @param arg The command-line argument, starting with "--".
+ * @return Returns SUCCESS (=0) if it was recognized and valid, otherwise
+ *         prints an error message and returns an error code.
+ */
+static int	apply_option(t_options *options, const char *arg)
+{
+	const t_option_spec	*spec;
+	size_t				len;
+	const char			*value;
+
+	spec = option_table();
+	while (spec->name)
+	{
+		len = strlen(spec->name);
+		if (strncmp(arg, spec->name, len) == 0
+			&& (arg[len] == '\0' || arg[len] == '='))
+		{
+			value = NULL;
+			if (arg[len] == '=')
+				value = arg + len + 1;
+			if (spec->handler(options, value) != SUCCESS)
+				return (option_error(arg));
+			return (SUCCESS);
+		}
+		spec++;
+	}
+	return (option_error(arg));
+}
+
+/**
+ * @brief Parses the leading `--option` arguments.
+ * 
+ * Options must come before the positional simulation arguments, e.g.
+ * `./philo --bench` or `./philo [options] 5 800 200 200 [7]`. Anything that
+ * does not start with "--" ends the option list.
+ * 
+ * @param options Receives the parsed options; unset ones are zero.
+ * @param argc The count of command-line arguments.
+ * @param argv The array of command-line argument strings.
+ * @return The index of the first positional argument, or -1 after printing
+ *         an error message if an option is invalid.
+ */
+int	parse_options(t_options *options, int argc, char *argv[])
+{
+	int	i;
+
+	memset(options, 0, sizeof(t_options));
+	i = 1;
+	while (i < argc && strncmp(argv[i], "--", 2) == 0)
+	{
+		if (apply_option(options, argv[i]) != SUCCESS)
+			return (-1);
+		i++;
+	}
+	return (i);
+}
@@ -0,0 +1,180 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   perf.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:35:07 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:35:07 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Returns the engines and fork strategies the suite measures.
+ * 
+ * @param count Receives the number of variants.
+ * @return A pointer to the first entry of the static table.
+ */
+static const t_perf_variant	*perf_variants(int *count)
+{
+	static const t_perf_variant	table[] = {
+	{"threads/ordered", ENGINE_THREADS, "ordered"},
+	{"threads/hierarchy", ENGINE_THREADS, "hierarchy"},
+	{"threads/waiter", ENGINE_THREADS, "waiter"},
+	{"threads/chandy-misra", ENGINE_THREADS, "chandy-misra"},
+	{"threads/priority", ENGINE_THREADS, "priority"},
+	{"threads/schedule", ENGINE_THREADS, "schedule"},
+	{"pool", ENGINE_POOL, NULL},
+	{"virtual", ENGINE_VIRTUAL, NULL}
+	};
+
+	*count = sizeof(table) / sizeof(table[0]);
+	return (table);
+}
+
+/**
+ * @brief Returns the fixed suite: every philosopher count with slack
+ *        timings, which nobody should die of, and with tight ones.
+ * 
+ * Odd counts make one philosopher wait a second round for forks, so
+ * 199 and 200 show the cost of that round at scale.
+ * 
+ * @return A pointer to the first entry of the static table, which ends
+ *         with a configuration of 0 philosophers.
+ */
+static const t_bench_config	*perf_suite(void)
+{
+	static const t_bench_config	suite[] = {
+	{1, 800, 200, 200, -1, PERF_RUN_MS}, {1, 410, 200, 200, -1, PERF_RUN_MS},
+	{2, 800, 200, 200, -1, PERF_RUN_MS}, {2, 410, 200, 200, -1, PERF_RUN_MS},
+	{5, 800, 200, 200, -1, PERF_RUN_MS}, {5, 410, 200, 200, -1, PERF_RUN_MS},
+	{199, 800, 200, 200, -1, PERF_RUN_MS},
+	{199, 410, 200, 200, -1, PERF_RUN_MS},
+	{200, 800, 200, 200, -1, PERF_RUN_MS},
+	{200, 410, 200, 200, -1, PERF_RUN_MS},
+	{1000, 800, 200, 200, -1, PERF_RUN_MS},
+	{1000, 410, 200, 200, -1, PERF_RUN_MS},
+	{10000, 800, 200, 200, -1, PERF_RUN_MS},
+	{10000, 410, 200, 200, -1, PERF_RUN_MS},
+	{0, 0, 0, 0, 0, 0}
+	};
+
+	return (suite);
+}
+
+/**
+ * @brief Prints one CSV row, in the format perf_baseline_load() reads, or
+ *        the header line.
+ * 
+ * @param row A measured row, or NULL for the header.
+ */
+static void	print_row(const t_perf_row *row)
+{
+	int	i;
+
+	i = -1;
+	if (!row)
+	{
+		printf("variant,n,die,eat,sleep");
+		while (++i < PERF_METRICS)
+			printf(",%s", perf_tolerances()[i].column);
+		printf("\n");
+		return ;
+	}
+	printf("%s,%d,%d,%d,%d", row->variant, row->config.philosopher_count,
+		row->config.time_to_die, row->config.time_to_eat,
+		row->config.time_to_sleep);
+	while (++i < PERF_METRICS)
+		printf(",%.1f", row->metrics[i]);
+	printf("\n");
+	fflush(stdout);
+}
+
+/**
+ * @brief Measures the whole suite on one variant.
+ * 
+ * A thread-engine case with over PERF_CROWDED philosophers per online CPU
+ * is marked crowded, which perf_compare() takes into account.
+ * 
+ * @param options The parsed command-line options.
+ * @param variant The variant.
+ * @param baseline The baseline to compare with, if `--perf=BASELINE`.
+ * @return The number of regressions, or -1 if a run failed.
+ */
+static int	perf_variant(const t_options *options,
+	const t_perf_variant *variant, const t_perf_baseline *baseline)
+{
+	const t_bench_config	*config;
+	t_options				variant_options;
+	t_perf_row				row;
+	int						regressions;
+
+	variant_options = *options;
+	variant_options.engine = variant->engine;
+	variant_options.strategy_set = variant->strategy != NULL;
+	if (variant_options.perf_runs == 0)
+		variant_options.perf_runs = PERF_RUNS;
+	if (variant->strategy)
+		variant_options.fork_strategy = fork_strategy_find(variant->strategy);
+	regressions = 0;
+	config = perf_suite();
+	while (config->philosopher_count > 0)
+	{
+		if (perf_measure(&variant_options, variant->name, config, &row)
+			!= SUCCESS)
+			return (-1);
+		row.crowded = variant->engine == ENGINE_THREADS
+			&& config->philosopher_count
+			> PERF_CROWDED * sysconf(_SC_NPROCESSORS_ONLN);
+		print_row(&row);
+		if (options->perf_baseline)
+			regressions += perf_compare(baseline, &row, TRUE);
+		config++;
+	}
+	return (regressions);
+}
+
+/**
+ * @brief Runs the `--perf` suite and prints it as CSV on stdout.
+ * 
+ * Every case runs `--runs=N` times (PERF_RUNS by default), each time in
+ * its own child process so that peak RSS and CPU time are its own, and
+ * its row holds the median of every metric (perf_run.c). With
+ * `--perf=BASELINE` each row is also compared with the same case in that
+ * file, and metrics outside their tolerance (perf_compare.c), as well as
+ * cases the baseline lacks, are reported on stderr. Fork waits are
+ * measured only by PHILO_STATS builds.
+ * 
+ * @param options The parsed command-line options.
+ * @return SUCCESS (=0), or FAILURE (=1) if a run failed or regressed.
+ */
+int	run_perf(const t_options *options)
+{
+	t_perf_baseline			baseline;
+	const t_perf_variant	*variants;
+	int						count;
+	int						regressions;
+	int						i;
+
+	baseline.count = 0;
+	if (options->perf_baseline && perf_baseline_load(&baseline,
+			options->perf_baseline) != SUCCESS)
+		return (FAILURE);
+	if (!PHILO_STATS)
+		print_error("Warning: fork waits need a PHILO_STATS build "
+			"(make perf).\n");
+	print_row(NULL);
+	variants = perf_variants(&count);
+	regressions = 0;
+	i = -1;
+	while (++i < count && regressions >= 0)
+		regressions += perf_variant(options, &variants[i], &baseline);
+	if (regressions < 0)
+		return (FAILURE);
+	if (regressions > 0)
+		return (print_error("Error: The perf suite regressed.\n"));
+	return (SUCCESS);
+}
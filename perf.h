@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   perf.h                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:32:47 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:32:47 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PERF_H
+# define PERF_H
+
+# include "stats.h"
+
+# define PERF_RUN_MS 1000 // < Length of one perf run.
+# define PERF_RUNS 5 // < Runs per case unless `--runs=N` says otherwise.
+# define PERF_MAX_RUNS 99 // < Most runs per case.
+# define PERF_METRICS 6 // < Measured columns of a perf row.
+# define PERF_MAX_ROWS 256 // < Most rows of a baseline file.
+# define PERF_NAME_MAX 32 // < Longest variant name, with its terminator.
+# define PERF_CROWDED 1000 // < Threads per CPU past which a case is crowded.
+
+/**
+ * @brief An engine, with the fork strategy of the thread engine.
+ */
+typedef struct s_perf_variant
+{
+	const char	*name; // < First CSV column, e.g. "threads/ordered".
+	int			engine; // < One of ENGINE_*.
+	const char	*strategy; // < `--strategy` name, or NULL.
+}	t_perf_variant;
+
+/**
+ * @brief One case of the suite, measured or read from a baseline.
+ * 
+ * The metrics are, in order: meals per second, p50 and p99 fork wait and
+ * death-detection latency in nanoseconds (-1 if not measured, or if
+ * nobody died), peak RSS in KiB and CPU time in milliseconds; each is the
+ * median of the runs of the case.
+ */
+typedef struct s_perf_row
+{
+	char			variant[PERF_NAME_MAX];
+	t_bench_config	config;
+	double			metrics[PERF_METRICS];
+	int				crowded;
+	// ^^^ TRUE if the case runs over PERF_CROWDED threads per online CPU.
+}	t_perf_row;
+
+/**
+ * @brief How far a metric may move the wrong way from its baseline before
+ *        it counts as a regression: the larger of both allowances.
+ */
+typedef struct s_perf_tolerance
+{
+	const char	*column; // < CSV column name.
+	int			higher_is_better; // < TRUE for throughput.
+	int			unmeasured_is_best; // < TRUE if -1 means "did not happen".
+	int			scheduled; // < TRUE if a crowded case does not compare it.
+	double		relative; // < Allowed change as a share of the baseline.
+	double		absolute; // < Allowed change in the metric's unit.
+}	t_perf_tolerance;
+
+/**
+ * @brief The rows of a committed baseline file.
+ */
+typedef struct s_perf_baseline
+{
+	t_perf_row	rows[PERF_MAX_ROWS];
+	int			count;
+}	t_perf_baseline;
+
+// perf_run.c
+int		perf_measure(const struct s_options *options, const char *variant,
+			const t_bench_config *config, t_perf_row *row);
+
+// perf_compare.c
+const t_perf_tolerance	*perf_tolerances(void);
+int		perf_baseline_load(t_perf_baseline *baseline, const char *path);
+int		perf_compare(const t_perf_baseline *baseline, const t_perf_row *row,
+			int report);
+
+#endif
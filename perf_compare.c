@@ -0,0 +1,186 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   perf_compare.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:33:45 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:33:45 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Returns the CSV column name and tolerance of every perf metric,
+ *        in the order of t_perf_row's metrics.
+ * 
+ * Fork waits are bimodal: a philosopher either finds the fork free or
+ * waits for most of a meal, and which one the median lands on changes
+ * from run to run. Their histogram buckets also double from one to the
+ * next. So waits may double and move by a few milliseconds before they
+ * count; latencies and CPU time get wide margins with an absolute floor
+ * too, and throughput and memory, which move little, tighter ones. A
+ * death where the baseline had none always counts (regressed()). In a
+ * crowded case only memory and CPU time are compared (perf_compare()).
+ * 
+ * @return A pointer to the first of PERF_METRICS entries.
+ */
+const t_perf_tolerance	*perf_tolerances(void)
+{
+	static const t_perf_tolerance	table[PERF_METRICS] = {
+	{"meals_per_sec", TRUE, FALSE, TRUE, 0.15, 1.5},
+	{"wait_p50_ns", FALSE, FALSE, TRUE, 1.00, 5000000},
+	{"wait_p99_ns", FALSE, FALSE, TRUE, 1.00, 20000000},
+	{"death_ns", FALSE, TRUE, TRUE, 1.00, 5000000},
+	{"max_rss_kb", FALSE, FALSE, FALSE, 0.25, 1024},
+	{"cpu_ms", FALSE, FALSE, FALSE, 0.50, 50}
+	};
+
+	return (table);
+}
+
+/**
+ * @brief Reads a baseline written by `--perf`; lines that are not rows,
+ *        such as the header, are skipped.
+ * 
+ * @param baseline Receives up to PERF_MAX_ROWS rows.
+ * @param path The baseline file.
+ * @return SUCCESS (=0), or FAILURE (=1) if the file cannot be read.
+ */
+int	perf_baseline_load(t_perf_baseline *baseline, const char *path)
+{
+	FILE		*file;
+	char		line[256];
+	t_perf_row	*row;
+
+	baseline->count = 0;
+	file = fopen(path, "r");
+	if (!file)
+		return (print_error("Error: Cannot read the perf baseline.\n"));
+	while (baseline->count < PERF_MAX_ROWS && fgets(line, sizeof(line), file))
+	{
+		row = &baseline->rows[baseline->count];
+		if (sscanf(line, "%31[^,],%d,%d,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf",
+				row->variant, &row->config.philosopher_count,
+				&row->config.time_to_die, &row->config.time_to_eat,
+				&row->config.time_to_sleep, &row->metrics[0],
+				&row->metrics[1], &row->metrics[2], &row->metrics[3],
+				&row->metrics[4], &row->metrics[5]) == 11)
+			baseline->count++;
+	}
+	fclose(file);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Finds the baseline row of the same variant and configuration.
+ * 
+ * @param baseline The loaded baseline.
+ * @param row A measured row.
+ * @return The baseline row, or NULL if the case is new.
+ */
+static const t_perf_row	*baseline_find(const t_perf_baseline *baseline,
+	const t_perf_row *row)
+{
+	const t_perf_row	*base;
+	int					i;
+
+	i = -1;
+	while (++i < baseline->count)
+	{
+		base = &baseline->rows[i];
+		if (strcmp(base->variant, row->variant) == 0
+			&& base->config.philosopher_count == row->config.philosopher_count
+			&& base->config.time_to_die == row->config.time_to_die
+			&& base->config.time_to_eat == row->config.time_to_eat
+			&& base->config.time_to_sleep == row->config.time_to_sleep)
+			return (base);
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Tells whether a metric moved the wrong way by more than its
+ *        tolerance.
+ * 
+ * A metric that is -1 in the baseline but measured now regressed if -1
+ * was the best value, as for a death that did not happen; otherwise a
+ * metric missing on either side, such as fork waits outside PHILO_STATS
+ * builds, is not compared.
+ * 
+ * @param tolerance The metric's tolerance.
+ * @param current The measured value.
+ * @param base The baseline value.
+ * @return TRUE (=1) for a regression, FALSE (=0) otherwise.
+ */
+static int	regressed(const t_perf_tolerance *tolerance, double current,
+	double base)
+{
+	double	allowance;
+
+	if (base < 0 && current >= 0)
+		return (tolerance->unmeasured_is_best);
+	if (current < 0 || base < 0)
+		return (FALSE);
+	allowance = tolerance->relative * base;
+	if (allowance < tolerance->absolute)
+		allowance = tolerance->absolute;
+	if (tolerance->higher_is_better)
+		return (current < base - allowance);
+	return (current > base + allowance);
+}
+
+/**
+ * @brief Compares a measured row with its baseline and, if asked to,
+ *        reports every metric outside its tolerance on stderr.
+ * 
+ * A case the baseline does not have is reported too, and counts as one
+ * regression, so that a stale baseline cannot pass by comparing nothing.
+ * 
+ * A crowded case compares only the metrics its scheduling does not
+ * decide. With thousands of threads per CPU, one round of the scheduler
+ * over them all takes longer than a death deadline, so throughput, fork
+ * waits and whether anybody dies depend on the order of that round and
+ * change from run to run; memory and CPU time do not.
+ * 
+ * @param baseline The loaded baseline.
+ * @param row A measured row.
+ * @param report TRUE (=1) to print the regressions, FALSE (=0) to count.
+ * @return The number of regressed metrics, 1 for a case without baseline.
+ */
+int	perf_compare(const t_perf_baseline *baseline, const t_perf_row *row,
+	int report)
+{
+	const t_perf_tolerance	*tolerance;
+	const t_perf_row		*base;
+	int						regressions;
+	int						i;
+
+	base = baseline_find(baseline, row);
+	if (!base && report)
+		fprintf(stderr, "Regression: %s %d %d %d %d: not in the baseline\n",
+			row->variant, row->config.philosopher_count,
+			row->config.time_to_die, row->config.time_to_eat,
+			row->config.time_to_sleep);
+	if (!base)
+		return (1);
+	tolerance = perf_tolerances();
+	regressions = 0;
+	i = -1;
+	while (++i < PERF_METRICS)
+	{
+		if ((row->crowded && tolerance[i].scheduled)
+			|| !regressed(&tolerance[i], row->metrics[i], base->metrics[i]))
+			continue ;
+		if (report)
+			fprintf(stderr, "Regression: %s %d %d %d %d: %s %.1f, "
+				"baseline %.1f\n", row->variant,
+				row->config.philosopher_count, row->config.time_to_die,
+				row->config.time_to_eat, row->config.time_to_sleep,
+				tolerance[i].column, row->metrics[i], base->metrics[i]);
+		regressions++;
+	}
+	return (regressions);
+}
@@ -0,0 +1,159 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   perf_run.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:33:11 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:33:11 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+#include <sys/resource.h> // struct rusage
+#include <sys/wait.h> // wait4(), WIFEXITED(), WEXITSTATUS()
+
+/**
+ * @brief Returns the user plus system CPU time of a resource usage.
+ * 
+ * @param usage Usage reported by wait4().
+ * @return The CPU time in milliseconds.
+ */
+static double	cpu_ms(const struct rusage *usage)
+{
+	return ((usage->ru_utime.tv_sec + usage->ru_stime.tv_sec) * 1e3
+		+ (usage->ru_utime.tv_usec + usage->ru_stime.tv_usec) / 1e3);
+}
+
+/**
+ * @brief Body of the child process of a perf run: runs the configuration
+ *        and writes the measurements bench_run() takes to the pipe.
+ * 
+ * @param options The options of the run.
+ * @param config The configuration to run.
+ * @param fd Write end of the pipe to the parent.
+ */
+static void	perf_child(const t_options *options, const t_bench_config *config,
+	int fd)
+{
+	t_bench_result	result;
+	double			metrics[PERF_METRICS];
+
+	if (bench_run(options, config, &result) != SUCCESS)
+		_exit(FAILURE);
+	metrics[0] = result.meals_per_sec;
+	metrics[1] = result.fork_wait_p50;
+	metrics[2] = result.fork_wait_p99;
+	metrics[3] = result.death_latency;
+	if (write(fd, metrics, sizeof(double) * 4) != sizeof(double) * 4)
+		_exit(FAILURE);
+	_exit(SUCCESS);
+}
+
+/**
+ * @brief Runs a configuration once, in a child process of its own.
+ * 
+ * The child is what makes peak RSS and CPU time per run measurable:
+ * wait4() reports both for the child alone, threads included, and no run
+ * inherits the heap or the page faults of the one before.
+ * 
+ * @param options The options of the run.
+ * @param config The configuration to run.
+ * @param metrics Receives the PERF_METRICS values of t_perf_row.
+ * @return SUCCESS (=0), or FAILURE (=1) after printing an error.
+ */
+static int	perf_run(const t_options *options, const t_bench_config *config,
+	double *metrics)
+{
+	struct rusage	usage;
+	int				fds[2];
+	pid_t			pid;
+	int				child;
+	int				received;
+
+	if (pipe(fds) != 0)
+		return (print_error("Error: Cannot start a perf run.\n"));
+	fflush(stdout);
+	pid = fork();
+	if (pid == 0)
+	{
+		close(fds[0]);
+		perf_child(options, config, fds[1]);
+	}
+	close(fds[1]);
+	received = (pid > 0 && read(fds[0], metrics, sizeof(double) * 4)
+			== sizeof(double) * 4);
+	close(fds[0]);
+	if (pid < 0 || wait4(pid, &child, 0, &usage) != pid || !received
+		|| !WIFEXITED(child) || WEXITSTATUS(child) != SUCCESS)
+		return (print_error("Error: A perf run failed.\n"));
+	metrics[4] = usage.ru_maxrss;
+	metrics[5] = cpu_ms(&usage);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Returns the median of some values, sorting them in place.
+ * 
+ * @param values The values.
+ * @param count How many there are, at least one.
+ * @return The middle value, or the mean of the two middle values.
+ */
+static double	median(double *values, int count)
+{
+	double	value;
+	int		i;
+	int		j;
+
+	i = 0;
+	while (++i < count)
+	{
+		value = values[i];
+		j = i;
+		while (j > 0 && values[j - 1] > value)
+		{
+			values[j] = values[j - 1];
+			j--;
+		}
+		values[j] = value;
+	}
+	if (count % 2 == 0)
+		return ((values[count / 2 - 1] + values[count / 2]) / 2);
+	return (values[count / 2]);
+}
+
+/**
+ * @brief Runs one case of the suite `perf_runs` times and keeps the
+ *        median of each metric.
+ * 
+ * @param options The options of the case, engine and strategy included.
+ * @param variant Name of the engine and strategy, for the CSV.
+ * @param config The configuration to run.
+ * @param row Receives the variant, the configuration and the medians.
+ * @return SUCCESS (=0), or FAILURE (=1) if a run failed.
+ */
+int	perf_measure(const t_options *options, const char *variant,
+	const t_bench_config *config, t_perf_row *row)
+{
+	double	samples[PERF_METRICS][PERF_MAX_RUNS];
+	double	metrics[PERF_METRICS];
+	int		run;
+	int		i;
+
+	run = -1;
+	while (++run < options->perf_runs)
+	{
+		if (perf_run(options, config, metrics) != SUCCESS)
+			return (FAILURE);
+		i = -1;
+		while (++i < PERF_METRICS)
+			samples[i][run] = metrics[i];
+	}
+	snprintf(row->variant, PERF_NAME_MAX, "%s", variant);
+	row->config = *config;
+	i = -1;
+	while (++i < PERF_METRICS)
+		row->metrics[i] = median(samples[i], options->perf_runs);
+	return (SUCCESS);
+}
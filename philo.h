@@ -6,7 +6,7 @@
 /*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/06/28 16:45:35 by hoskim            #+#    #+#             */
-/*   Updated: 2025/07/16 00:11:53 by hoskim           ###   ########seoul.kr  */
+/*   Updated: 2026/10/14 19:31:58 by hoskim           ###   ########seoul.kr  */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,9 +15,18 @@
 
 # include <stdlib.h> // malloc(), free()
 # include <stdio.h> // printf()
+# include <string.h> // memset()
+# include <limits.h> // LLONG_MAX
 # include <pthread.h> // pthread_create(), pthread_mutex_lock()...
 # include <unistd.h> // write(), usleep()
-# include <sys/time.h> // gettimeofday(), struct timeval
+# include <time.h> // clock_gettime(), struct timespec
+# include <stdatomic.h> // _Atomic, atomic_load_explicit()...
+# include <stddef.h> // offsetof()
+# include "arena.h"
+# include "log.h"
+# include "stats.h"
+# include "sweep.h"
+# include "perf.h"
 
 # define SUCCESS 0
 # define FAILURE 1
@@ -26,27 +35,521 @@
 # define DEAD 1
 # define NOT_DEAD 0
 
+# define NS_PER_SEC 1000000000LL
+# define NS_PER_MS 1000000LL
+# define NS_PER_US 1000LL
+# define SLEEP_SPIN_NS 100000LL
+// ^^^ Final part of every sleep that is busy-waited instead of slept.
+# define FUTEX_CANCEL_POLL_NS 1000000LL
+// ^^^ Cancel check period of fork waits on kernels without futex_waitv().
+# define THINK_SLICE_NS 500000LL
+// ^^^ How often a yielding philosopher checks whether a neighbour ate.
+# define BENCH_RUN_MS 2000 // < Length of one benchmark run.
+# define STATS_TABLE 0
+# define STATS_JSON 1
+# define OUTPUT_FULL 0 // < `--output=full`: every event (the default).
+# define OUTPUT_STATE 1 // < `--output=state`: no fork pickups.
+# define OUTPUT_SUMMARY 2 // < `--output=summary`: deaths and a summary.
+# define THINK_ADAPTIVE 0 // < `--think=adaptive`: yield by slack (default).
+# define THINK_FIXED 1 // < `--think=fixed`: the strategy's fixed delay.
+# define ENGINE_THREADS 0 // < One thread per philosopher (the default).
+# define ENGINE_POOL 1 // < Philosophers multiplexed onto worker threads.
+# define ENGINE_VIRTUAL 2 // < Discrete-event run on a simulated clock.
+
+# define WHEEL_BITS 6 // < log2 of the slots per timer wheel level.
+# define WHEEL_SLOTS 64 // < Slots per level, one occupancy bit each.
+# define WHEEL_LEVELS 6 // < Levels; together they span 2^36 ticks.
+# define WHEEL_FAR_SLOT 384 // < `WHEEL_LEVELS * WHEEL_SLOTS`: beyond that.
+# define WHEEL_TICK_SHIFT 16 // < One wheel tick is 2^16 ns (~65.5 us).
+# define TIMER_TRANSITION 0 // < End of a task's eat, sleep or think.
+# define TIMER_DEATH 1 // < A task's death deadline.
+# define POOL_IDLE_WAIT_NS 1000000000LL
+// ^^^ Longest a worker with no pending timer sleeps before rechecking.
+
+# define AFFINITY_MAX_NODES 64 // < NUMA nodes looked up under /sys.
+# define LAUNCHERS_MAX 64 // < Most `--launchers` threads.
+# define MONITORS_MAX 64 // < Most `--monitors` shards.
+# define MONITOR_SHARD_SIZE 8192 // < Philosophers per shard by default.
+# define METRICS_INTERVAL_MS 1000 // < Default `--metrics-interval`.
+# define METRICS_COUNT 7 // < Metrics in each snapshot.
+# define FORK_SPIN_MAX 200 // < Most cpu_relax() rounds before a fork wait sleeps.
+# define TOPOLOGY_RING 0 // < `--topology` kinds; the ring is the default.
+# define TOPOLOGY_GRID 1
+# define TOPOLOGY_TORUS 2
+# define TOPOLOGY_RANDOM 3
+# define TOPOLOGY_FILE 4
+# define TOPOLOGY_MAX_FORKS 16 // < Most forks one philosopher may need.
+# define BATCH_LINE_MAX 256 // < Longest `--batch` line, newline included.
+# define BATCH_MAX_ARGS 6 // < "philo" plus the five positional arguments.
+# define SCHEDULE_MAX_COLORS 64 // < Most classes `--strategy=schedule` uses.
+# define TOPOLOGY_MAX_INDEX 100000000 // < Largest fork index in a file.
+# define FORK_FREE 0 // < Pool engine fork states, see pool_fork.c.
+# define FORK_HELD 1
+# define FORK_CONTENDED 2
+
+/*
+ * Clock behind get_time_ns(). Building with -DPHILO_COARSE_CLOCK selects the
+ * cheaper, tick-resolution CLOCK_MONOTONIC_COARSE instead.
+ */
+# ifdef PHILO_COARSE_CLOCK
+#  define PHILO_CLOCK_ID CLOCK_MONOTONIC_COARSE
+# else
+#  define PHILO_CLOCK_ID CLOCK_MONOTONIC
+# endif
+
 typedef struct s_simulation	t_simulation;
+typedef struct s_philosopher	t_philosopher;
+typedef struct s_worker		t_worker;
+typedef struct s_crew		t_crew;
+
+/**
+ * @brief Which forks each philosopher needs, as given by `--topology`.
+ */
+typedef struct s_topology_spec
+{
+	int				kind; // < One of TOPOLOGY_*.
+	int				param; // < Grid/torus width, or forks per philosopher.
+	unsigned int	seed; // < Seed of TOPOLOGY_RANDOM.
+	const char		*path; // < File of TOPOLOGY_FILE.
+}	t_topology_spec;
+
+/**
+ * @brief Options given as leading `--name[=value]` arguments.
+ */
+typedef struct s_options
+{
+	int	bench; // < `--bench`: run the benchmark matrix instead.
+	int	sweep; // < `--sweep`: the arguments are ranges to sweep instead.
+	const char	*batch_path; // < `--batch[=PATH]`: configurations, "-" stdin.
+	int	perf; // < `--perf[=BASELINE]`: run the perf suite instead.
+	const char	*perf_baseline; // < Baseline CSV to compare with, or NULL.
+	int	perf_runs; // < `--runs=N`: runs per perf case, 0 for PERF_RUNS.
+	int	quiet; // < Suppress per-event output (set by the benchmark).
+	int	stats_format; // < `--stats=table|json`: STATS_TABLE or STATS_JSON.
+	int	trace_format; // < `--trace=text|binary`: LOG_FORMAT_*.
+	int	output; // < `--output=full|state|summary`: OUTPUT_*.
+	unsigned int	muted_events; // < Bit per t_log_event `--output` drops.
+	int	think; // < `--think=adaptive|fixed`: THINK_*.
+	const char	*trace_path; // < `--trace-file=PATH`: mmap'd trace, or NULL.
+	const char	*metrics_path; // < `--metrics=PATH`: metrics file, or NULL.
+	int	metrics_interval_ms; // < `--metrics-interval=MS`, 0 for the default.
+	int	engine; // < `--engine=threads|pool|virtual`: one of ENGINE_*.
+	int	workers; // < `--workers=N`: pool size, 0 for one per CPU.
+	int	fork_strategy; // < `--strategy=NAME`: index in the strategy table.
+	int	strategy_set; // < Whether `--strategy` was given.
+	t_topology_spec	topology; // < `--topology=SPEC`: who needs which forks.
+	int	pin; // < `--pin`: pin threads and place memory by NUMA node.
+	int	stack_kb; // < `--stack-size=KB`: arena thread stacks, 0 for none.
+	int	launchers; // < `--launchers=N`: threads creating philosophers.
+	int	monitors; // < `--monitors=N`: death monitor shards, 0 for auto.
+}	t_options;
+
+/**
+ * @brief Entry of the option table: `--name` and the handler for its value.
+ */
+typedef struct s_option_spec
+{
+	const char	*name;
+	int			(*handler)(t_options *options, const char *value);
+}	t_option_spec;
+
+/**
+ * @brief One thread of a t_crew, with its index among the pool workers.
+ */
+typedef struct s_crew_member
+{
+	t_crew		*crew; // < The crew the thread belongs to.
+	int			index; // < Worker it runs in each simulation.
+	int			generation; // < Last run it has seen.
+	pthread_t	thread; // < Thread handle.
+}	t_crew_member;
+
+/**
+ * @brief `--engine=pool` worker threads kept parked between `--batch`
+ *        runs, see pool_crew.c.
+ */
+typedef struct s_crew
+{
+	t_crew_member	**members; // < Created threads, grown as runs need.
+	int				count; // < Number of members.
+	t_simulation	*simulation; // < The run being worked on, NULL to quit.
+	_Atomic int		generation; // < Bumped once per run; futex word.
+	_Atomic int		busy; // < Workers still in the run; futex word.
+}	t_crew;
+
+/**
+ * @brief A `--batch` run: the input line being run and what is carried
+ *        from one simulation to the next.
+ */
+typedef struct s_batch
+{
+	const t_options	*options; // < The options every run starts from.
+	t_arena			arena; // < Mapping handed from run to run.
+	t_crew			crew; // < Pool workers handed from run to run.
+	char			line[BATCH_LINE_MAX]; // < Split in place into `argv`.
+	char			*argv[BATCH_MAX_ARGS + 1]; // < argv[0] is "philo".
+	int				argc;
+	int				failures; // < Lines that did not run.
+}	t_batch;
+
+/**
+ * @brief A way of acquiring forks, selected with `--strategy=NAME`.
+ * 
+ * Used by the thread engine; acquire_forks() and release_forks() dispatch
+ * to the selected entry. The pool engine has its own non-blocking forks.
+ */
+typedef struct s_fork_strategy
+{
+	const char	*name; // < Value of `--strategy=`.
+	int			(*init)(t_simulation *sim); // < NULL if it needs no state.
+	size_t		(*size)(t_simulation *sim); // < Arena bytes init() takes.
+	void		(*destroy)(t_simulation *sim); // < NULL if it has no state.
+	int			(*acquire)(t_philosopher *philo); // < FALSE if cancelled.
+	void		(*release)(t_philosopher *philo); // < Puts both back.
+	void		(*think)(t_philosopher *philo); // < `--think=fixed` delay, or NULL.
+	void		(*leave)(t_philosopher *philo); // < Told of a leaver, or NULL.
+	void		(*cancel)(t_simulation *sim); // < Wakes its waits, or NULL.
+	int			any_topology; // < FALSE if it only works on the ring.
+}	t_fork_strategy;
+
+/**
+ * @brief State of the waiter strategy: one arbitrator for all forks.
+ * 
+ * A hungry philosopher draws a ticket and waits until both forks are free
+ * and no neighbour with an older ticket is about to eat, all under one
+ * mutex. The priority strategy uses the philosopher's death deadline as
+ * the ticket instead, so the hungriest neighbour goes first.
+ */
+typedef struct s_waiter
+{
+	pthread_mutex_t	mutex; // < Guards everything below.
+	int				by_deadline; // < TRUE for `--strategy=priority`.
+	long			next_ticket; // < Last ticket handed out.
+	long			*tickets; // < Ticket of each hungry philosopher, else 0.
+	char			*fork_busy; // < TRUE while a fork is in use.
+	pthread_cond_t	*turns; // < One per philosopher, signalled by neighbours.
+	int				mutex_ready; // < TRUE once `mutex` is initialized.
+	int				turns_ready; // < How many of `turns` are initialized.
+}	t_waiter;
+
+/**
+ * @brief One fork of the Chandy-Misra strategy, with its request token.
+ * 
+ * Each fork has one request token. The two philosophers who share the
+ * fork pass the fork and the token between them as messages. Hungry and
+ * without the fork, a philosopher sends the token to the owner. The owner
+ * answers with the fork, cleaned, as soon as it is dirty and they are
+ * not eating. A clean fork therefore stays with its owner until they
+ * have eaten with it.
+ */
+typedef struct s_chandy_fork
+{
+	pthread_mutex_t	mutex; // < Guards the fork and its owner's `eating`.
+	pthread_cond_t	cond; // < Signalled when the fork changes hands.
+	int				owner; // < Index of the philosopher who owns the fork.
+	int				request; // < Who holds the request token.
+	// ^^^ The owner too once the other philosopher asked for the fork.
+	int				dirty; // < TRUE once the owner has eaten with it.
+}	t_chandy_fork;
+
+/**
+ * @brief State of the Chandy-Misra strategy.
+ */
+typedef struct s_chandy
+{
+	t_chandy_fork	*forks; // < One per fork.
+	char			*eating; // < Per philosopher; written under both forks.
+	int				ready; // < How many forks are initialized.
+}	t_chandy;
+
+/**
+ * @brief State of the schedule strategy: philosophers eating in rounds.
+ * 
+ * Round `r` opens gate `r % gate_count`, which then holds `r`. Everyone
+ * whose next turn is `r` eats in it; the last of them to finish opens the
+ * next round that somebody still at the table has a turn in. With color
+ * classes a turn is followed by the same class's next round; on an odd
+ * ring the rounds rotate instead (`rotating`).
+ */
+typedef struct s_schedule
+{
+	_Atomic int		gates[SCHEDULE_MAX_COLORS]; // < Per round; futex words.
+	_Atomic int		remaining; // < Eaters of the open round not done yet.
+	int				gate_count; // < Gates in use.
+	int				color_count; // < Number of classes, when not rotating.
+	int				rotating; // < TRUE on an odd ring; see schedule_color().
+	int				count; // < Number of philosophers.
+	int				*turns; // < Next round of each philosopher, its own only.
+	char			*left; // < Per philosopher, guarded by `open_mutex`.
+	pthread_mutex_t	open_mutex; // < Serializes opening gates and leaving.
+	int				mutex_ready; // < TRUE once `open_mutex` is initialized.
+}	t_schedule;
+
+/**
+ * @brief A death deadline tracked by the monitor.
+ */
+typedef struct s_deadline
+{
+	long long	deadline; // < `last_meal_time + time_to_die`, in ns.
+	int			index; // < Index of the philosopher it belongs to.
+}	t_deadline;
+
+/**
+ * @brief Binary min-heap of death deadlines, owned by the monitor thread.
+ */
+typedef struct s_deadline_heap
+{
+	t_deadline	*entries; // < Heap storage, earliest deadline first.
+	int			size; // < Number of entries.
+}	t_deadline_heap;
+
+/**
+ * @brief One shard of the thread engine's death monitor.
+ * 
+ * Shard `k` watches a contiguous range of philosophers with its own heap,
+ * a slice of `deadlines`. With a single shard the main thread runs it;
+ * otherwise every shard has a thread of its own.
+ */
+typedef struct s_monitor_shard
+{
+	_Alignas(CACHE_LINE_SIZE) t_deadline_heap	heap;
+	// ^^^ Deadlines of the shard's philosophers.
+	int											first; // < First one.
+	t_simulation								*simulation;
+	long long									death_latency_ns;
+	// ^^^ Detection delay of the death the shard found.
+	long long									death_time;
+	// ^^^ Time of the shard's latest check, that of the death once found.
+	pthread_t									thread;
+	int											started;
+	// ^^^ Whether `thread` was created.
+}	t_monitor_shard;
+
+/**
+ * @brief FIFO ticket lock guarding one fork of the thread engine.
+ * 
+ * A philosopher draws `next` and owns the fork once `serving` reaches
+ * their ticket, so the fork goes to whoever asked first instead of to
+ * whoever happens to run; in particular, a philosopher who just put the
+ * fork down cannot grab it back from a waiting neighbour. Waiters spin
+ * for a short adaptive budget and then sleep on `serving` as a futex.
+ */
+typedef struct s_fork_lock
+{
+	_Atomic int		next; // < Ticket dispenser; wraps around harmlessly.
+	_Atomic int		serving; // < Ticket of the current holder; futex word.
+	_Atomic int		sleepers; // < Waiters asleep in the futex.
+	_Atomic int		spin; // < Learned spin budget, in cpu_relax() rounds.
+	_Atomic long	waits; // < Acquires not served at once, for `--metrics`.
+}	t_fork_lock;
+
+/**
+ * @brief Seat structure: the hot, frequently written part of a philosopher
+ *        together with the fork on their left.
+ * 
+ * Seats are allocated as one cache-line-aligned array, so seat `i` holds
+ * philosopher `i`'s meal state on one cache line and fork `i` (their left
+ * fork) on the next one. Neighbouring philosophers' meal state and adjacent
+ * forks therefore never share a cache line.
+ * 
+ * `meals_eaten` and `last_meal_time` are written only by the owning thread
+ * (release) and read by the monitor (acquire), so neither side takes a lock.
+ */
+typedef struct s_seat
+{
+	_Alignas(CACHE_LINE_SIZE) _Atomic long long	last_meal_time;
+	// ^^^ Timestamp of the last meal start in nanoseconds (get_time_ns()).
+	_Atomic int									meals_eaten;
+	// ^^^ Number of meals eaten so far.
+	_Alignas(CACHE_LINE_SIZE) t_fork_lock		fork;
+	// ^^^ Lock of fork `i`, the left fork of the seat's philosopher.
+	_Atomic int									fork_state;
+	// ^^^ The same fork under the pool engine, which never blocks on it.
+}	t_seat;
 
 /**
  * @brief Philosopher structure
  * 
  * Represents a philosopher in the Dining Philosophers Problem.
- * Each philosopher has a unique ID, meal count, fork indices, last meal time,
- * and runs on its own thread.
+ * Each philosopher has a unique ID, fork indices, a pointer to their seat
+ * (meal count and last meal time) and runs on its own thread.
+ * These cold fields are written once during setup and only read afterwards.
  */
-typedef struct s_philosopher
+struct s_philosopher
 {
-	int				id;
+	int					id;
 	// ^^^ Unique identifier for the philosopher (starting from 1).
-	int				meals_eaten; // < Number of meals eaten so far.
-	int				left_fork_index; // < Index of the left fork.
-	int				right_fork_index; // < Index of the right fork.
-	long long		last_meal_time;
-	// ^^^ Timestamp of the last meal start in milliseconds.
-	t_simulation	*simulation; // < Pointer to the simulation data.
-	pthread_t		thread; // < Thread handle for this philosopher.
-}	t_philosopher;
+	int					left_fork_index; // < Index of the left fork.
+	int					right_fork_index; // < Index of the right fork.
+	// ^^^ Both are those of the ring; other topologies only use `forks`.
+	const int			*forks; // < Every fork needed, ascending (CSR row).
+	int					fork_count; // < Length of `forks`.
+	t_seat				*seat; // < Hot meal state and left fork.
+	t_simulation		*simulation; // < Pointer to the simulation data.
+	t_log_ring			*log_ring; // < Ring this thread logs into.
+	t_philo_stats		*stats; // < Measurement slot, NULL unless PHILO_STATS.
+	pthread_t			thread; // < Thread handle for this philosopher.
+	int					started; // < Whether `thread` was created.
+};
+
+/**
+ * @brief Timer linked into a timer wheel slot.
+ */
+typedef struct s_timer
+{
+	long long		expires; // < Absolute expiry time in nanoseconds.
+	struct s_timer	*next; // < Next timer in the same slot.
+	struct s_timer	**pprev; // < Link pointing at this one, NULL if unarmed.
+	int				slot; // < Slot the timer is linked into.
+	int				kind; // < TIMER_TRANSITION or TIMER_DEATH.
+}	t_timer;
+
+/**
+ * @brief Hierarchical timer wheel owned by one pool worker.
+ * 
+ * Ticks are split into WHEEL_BITS-bit digits, one per level. A timer sits
+ * on the lowest level whose digit is the highest one in which its tick
+ * differs from `current`, in the slot of that digit. So the next slot to
+ * handle is always the lowest occupied slot of the lowest non-empty level:
+ * level 0 slots expire, higher slots cascade into lower levels once
+ * `current` reaches them. Insert, removal and finding the next event are
+ * all O(1). Timers beyond the top level wait in the far slot.
+ */
+typedef struct s_timer_wheel
+{
+	t_timer			*slots[WHEEL_FAR_SLOT + 1]; // < Unsorted timer lists.
+	unsigned long	occupied[WHEEL_LEVELS]; // < Used slots, per level.
+	long long		current; // < Current tick, never ahead of a timer.
+}	t_timer_wheel;
+
+/**
+ * @brief States of a philosopher run by the pool engine.
+ */
+typedef enum e_task_state
+{
+	TASK_THINKING,
+	TASK_HUNGRY,
+	TASK_EATING,
+	TASK_SLEEPING
+}	t_task_state;
+
+/**
+ * @brief A philosopher as a state machine of the pool engine.
+ * 
+ * Only the owning worker touches a task, except for `inbox_next`, which
+ * a neighbouring worker writes when it hands a fork over.
+ */
+typedef struct s_task
+{
+	t_timer			timer;
+	// ^^^ Pending eat/sleep/think end; first, so a t_timer * is the task.
+	t_timer			death; // < `last_meal_time + time_to_die`.
+	t_philosopher	*philo; // < The philosopher this task runs.
+	t_worker		*worker; // < Worker that owns the task.
+	int				state; // < One of t_task_state.
+	int				forks_held; // < Forks held so far, in acquisition order.
+	long long		hunger_start; // < When the task became hungry.
+	long long		fork_request; // < When the pending fork was requested.
+	long long		think_until; // < End of the yield of think_until().
+	struct s_task	*inbox_next; // < Link in the owner's inbox.
+}	t_task;
+
+/**
+ * @brief Worker thread of the pool engine.
+ * 
+ * A worker runs a contiguous block of philosophers, so most forks are
+ * shared by two tasks of the same worker. A fork handed over to a task of
+ * another worker goes through that worker's lock-free inbox and wakes it
+ * through the `wake` futex if it is parked.
+ */
+struct s_worker
+{
+	_Alignas(CACHE_LINE_SIZE) _Atomic(t_task *)	inbox;
+	// ^^^ Tasks granted a fork by another worker (Treiber stack).
+	_Atomic int									wake;
+	// ^^^ Futex word, bumped to wake the parked worker.
+	_Atomic int									parked;
+	// ^^^ Set while the worker is (about to be) asleep on `wake`.
+	_Alignas(CACHE_LINE_SIZE) t_timer_wheel		wheel;
+	// ^^^ Eat, sleep and think ends and death deadlines of its tasks.
+	t_simulation								*simulation;
+	int											first; // < First task index.
+	int											end; // < One past the last.
+	pthread_t									thread;
+};
+
+/**
+ * @brief State of the pool engine (`--engine=pool`).
+ */
+typedef struct s_pool
+{
+	t_worker	*workers; // < Cache-aligned worker array.
+	int			worker_count; // < Number of workers.
+	t_task		*tasks; // < One task per philosopher.
+}	t_pool;
+
+/**
+ * @brief CPUs the threads are pinned to with `--pin`, grouped by node.
+ * 
+ * The allowed CPUs are listed node by node, so consecutive threads, and
+ * therefore neighbouring philosophers, land on the same NUMA node.
+ */
+typedef struct s_affinity
+{
+	int	*cpus; // < Allowed CPUs, NUMA node by NUMA node.
+	int	*nodes; // < Node of each entry of `cpus`, -1 if unknown.
+	int	count; // < Number of CPUs, 0 unless `--pin` was given.
+	int	node_count; // < Distinct nodes among them.
+}	t_affinity;
+
+/**
+ * @brief The forks of every philosopher in compressed sparse row layout.
+ * 
+ * Philosopher `i` needs forks `forks[offsets[i]]` up to, but excluding,
+ * `forks[offsets[i + 1]]`, in ascending order. The rows lie back to back
+ * in one array, so a philosopher's forks are one contiguous read.
+ */
+typedef struct s_topology
+{
+	long	total; // < Length of `forks`.
+	int		*offsets; // < `philosopher_count + 1` row starts.
+	int		*forks; // < Fork indices, row by row.
+	char	*text; // < Contents of the `--topology=file:` file while set up.
+}	t_topology;
+
+/**
+ * @brief One snapshot of a running simulation, taken by metrics_sample().
+ */
+typedef struct s_metrics_sample
+{
+	long long	now; // < Time of the snapshot, in ns.
+	long		meals; // < Meals eaten so far, by everybody.
+	long long	worst_slack; // < Least time left before a death, in ns.
+	long		fork_waits; // < Fork acquires that had to wait so far.
+	long		backlog; // < Events waiting in the log rings.
+}	t_metrics_sample;
+
+/**
+ * @brief Name, Prometheus type and help text of one exported metric.
+ */
+typedef struct s_metric_spec
+{
+	const char	*name;
+	const char	*type; // < "counter" or "gauge".
+	const char	*help;
+}	t_metric_spec;
+
+/**
+ * @brief State of the `--metrics` thread.
+ */
+typedef struct s_metrics
+{
+	int			active; // < Whether metrics_start() ran with a path.
+	int			running; // < Whether `thread` was created.
+	pthread_t	thread; // < Thread rewriting the metrics file.
+	long long	last_time; // < Time of the previous snapshot, in ns.
+	long		last_meals; // < Meal total of the previous snapshot.
+}	t_metrics;
 
 /**
  * @brief Simulation structure for the Dining Philosophers Problem
@@ -67,30 +570,331 @@ typedef struct s_simulation
 	// ^^^ Time (ms) a philosopher sleeps after eating; argv[4]
 	int				required_meals;
 	// ^^^ Number od meals each philosopher must eat (-1 if unlimited); argv[5]
-	int				simulation_ended;
-	// ^^^ Flag indicating if the simulation has ended.
+	int				time_limit_ms;
+	// ^^^ Ends the simulation after this long if positive (benchmark runs).
+	t_options		options; // < Parsed `--options`.
+	_Atomic int		simulation_ended;
+	// ^^^ Flag indicating if the simulation has ended (release/acquire).
 	long long		sim_start_time;
-	// ^^^ Timestamp when the simulation started (in milliseconds).
+	// ^^^ Timestamp when the simulation started (in nanoseconds).
 	t_philosopher	*philosophers; // < Array of philosopher structures.
-	pthread_mutex_t	*fork_mutexes; // < Array of mutex locks for each fork.
-	pthread_mutex_t	print_mutex; // < Mutex for synchronized printing to stdout.
-	pthread_mutex_t	data_mutex; // < Mutex for protecting shared data access.
+	t_seat			*seats; // < Cache-aligned meal state and fork per seat.
+	int				seat_count; // < Philosophers or forks, whichever is more.
+	t_topology		topology; // < Forks of every philosopher.
+	t_logger		logger; // < Asynchronous writer for the status output.
+	_Atomic int		satisfied_count;
+	// ^^^ Number of philosophers who have eaten `required_meals` times.
+	t_deadline_heap	deadlines; // < Storage of every shard's deadlines.
+	t_monitor_shard	*shards; // < Death monitor shards of the thread engine.
+	int				shard_count; // < Number of shards, 0 for other engines.
+	long long		stop_time; // < Absolute end of the time limit, in ns.
+	long long		death_latency_ns;
+	// ^^^ Delay between a death deadline and its detection, -1 if none.
+	long long		death_time; // < When the death was detected, in ns.
+	t_philo_stats	*stats; // < Per-philosopher stats, NULL unless PHILO_STATS.
+	pthread_mutex_t	monitor_mutex; // < Guards the monitor's wake-up.
+	pthread_cond_t	monitor_cond; // < Wakes the monitor on satisfaction.
+	t_pool			pool; // < Worker pool of ENGINE_POOL and ENGINE_VIRTUAL.
+	t_crew			*crew; // < Parked `--batch` workers, or NULL.
+	const t_fork_strategy	*strategy; // < Selected fork strategy.
+	void			*strategy_data; // < t_waiter, t_chandy or t_schedule.
+	t_affinity		affinity; // < Thread and memory placement of `--pin`.
+	t_arena			arena; // < Holds everything allocated per simulation.
+	char			*stacks; // < Arena thread stacks, NULL for pthread's own.
+	size_t			stack_size; // < Size of each arena stack in bytes.
+	int				launched; // < Pool workers created.
+	long long		sleep_spin_ns;
+	// ^^^ Busy-waited tail of every sleep: SLEEP_SPIN_NS, or 0 if the
+	// philosophers outnumber the CPUs.
+	long long		virtual_now; // < Simulated clock of ENGINE_VIRTUAL, in ns.
+	_Atomic int		start_gate;
+	// ^^^ Set once every thread is created and the start time is taken.
+	t_metrics		metrics; // < `--metrics` thread and its last snapshot.
 }	t_simulation;
 
+/**
+ * @brief A `--launchers` thread and the philosophers it creates.
+ */
+typedef struct s_launcher
+{
+	t_simulation	*simulation; // < The simulation being launched.
+	int				first; // < First philosopher to create.
+	int				end; // < One past the last philosopher to create.
+	int				status; // < SUCCESS, or FAILURE if a thread failed.
+	int				started; // < Whether `thread` was created.
+	pthread_t		thread; // < Thread handle for this launcher.
+}	t_launcher;
+
+// log_summary.c
+void		log_summary(t_simulation *sim);
+
 // utils.c
+int			is_event_muted(t_simulation *sim, t_log_event event);
 int			print_error(char *error_message);
 int			ft_atoi(const char *str);
-long long	get_current_time_ms(void);
+long long	print_timestamp_and_philo_status_msg(
+				t_philosopher *philo, t_log_event event);
+void		log_philo_status(t_philosopher *philo, t_log_event event);
+
+// philo_time.c
+long long	get_time_ns(void);
+long long	ms_to_ns(long long milliseconds);
+void		ns_to_timespec(long long nanoseconds, struct timespec *out);
+int			init_monotonic_cond(pthread_cond_t *cond);
+long long	simulation_time(t_simulation *sim);
+
+// futex.c
+void		futex_wait(_Atomic int *word, int expected);
+void		futex_wait_until(_Atomic int *word, int expected, long long deadline);
+void		futex_wait_cancellable(_Atomic int *word, int expected,
+				_Atomic int *cancel);
+void		futex_wake_all(_Atomic int *word);
+
+// precise_sleep.c
+void		cpu_relax(void);
+long long	precise_sleep_until(t_philosopher *philo, long long now,
+				long long deadline);
+
+// options.c
+int			parse_options(t_options *options, int argc, char *argv[]);
+
+// state.c
 int			is_simulation_finished(t_simulation *sim);
-void		print_timestamp_and_philo_status_msg(
-				t_philosopher *philo, const char *message, int is_dead);
+int			end_simulation(t_simulation *sim);
+void		record_meal(t_philosopher *philo, long long meal_time);
+long long	get_last_meal_time(t_philosopher *philo);
+int			get_meals_eaten(t_philosopher *philo);
+
+// deadline_heap.c
+int			deadline_heap_init(t_deadline_heap *heap, t_arena *arena,
+				int capacity);
+void		deadline_heap_build(t_deadline_heap *heap, t_simulation *sim,
+				int first);
+void		deadline_heap_update_top(t_deadline_heap *heap, long long deadline);
+
+// monitor.c
+void		notify_monitor(t_simulation *sim);
+int			check_for_death(t_monitor_shard *shard);
+
+// topology.c
+int			topology_measure(t_simulation *sim);
+int			topology_init(t_simulation *sim);
+
+// topology_gen.c
+int			topology_generate(t_simulation *sim, int index, int *forks);
+
+// topology_file.c
+int			topology_file_load(t_simulation *sim);
+int			topology_file_next(const char **cursor, int *forks);
+
+// monitor_shard.c
+int			monitor_shard_count(t_simulation *sim);
+int			monitor_shards_init(t_simulation *sim);
+int			shard_report_death(t_monitor_shard *shard, int dead_id);
+int			monitor_shards_start(t_simulation *sim);
+void		monitor_simulation(t_simulation *sim);
 
 // init.c
-int			initialize_simulation(t_simulation *sim, int argc, char *argv[]);
+int			parse_cmd_line_args(t_simulation *sim, int argc, char *argv[]);
+int			prepare_simulation(t_simulation *sim);
+int			initialize_simulation(t_simulation *sim, const t_options *options,
+				int argc, char *argv[]);
+
+// stats.c
+int			stats_init(t_simulation *sim);
+
+// stats_dump.c
+void		stats_dump(t_simulation *sim);
+
+// launch.c
+int			launch_philosopher_threads(t_simulation *sim);
+
+// start_gate.c
+void		start_gate_wait(t_simulation *sim);
+void		start_gate_open(t_simulation *sim);
+int			start_simulation_clock(t_simulation *sim);
+
+// fork_lock.c
+void		fork_lock_init(t_fork_lock *lock);
+int			fork_lock_acquire(t_fork_lock *lock, _Atomic int *cancel);
+void		fork_lock_release(t_fork_lock *lock);
+
+// sim_arena.c
+int			simulation_arena_init(t_simulation *sim, int threads,
+				size_t capacity);
+int			thread_attr_init(t_simulation *sim, int index, int total,
+				pthread_attr_t *attr);
+
+// affinity.c
+int			affinity_init(t_simulation *sim);
+void		affinity_destroy(t_simulation *sim);
+
+// affinity_place.c
+int			affinity_slot_node(t_simulation *sim, int index, int total);
+int			affinity_pin(t_simulation *sim, int index, int total,
+				pthread_attr_t *attr);
+void		affinity_pin_self(t_simulation *sim, int index, int total);
+
+// affinity_memory.c
+void		affinity_bind_memory(t_simulation *sim);
+
+// forks.c
+void		announce_fork(t_philosopher *philo, t_log_event event,
+				long long wait_start);
+int			lock_fork(t_philosopher *philo, int fork_index, t_log_event event);
+void		unlock_forks(t_philosopher *philo);
+int			acquire_forks(t_philosopher *philo);
+void		release_forks(t_philosopher *philo);
+
+// fork_strategy.c
+int			fork_strategy_find(const char *name);
+int			fork_strategy_init(t_simulation *sim);
+void		fork_strategy_destroy(t_simulation *sim);
+size_t		fork_strategy_size(t_simulation *sim);
+
+// fork_ordered.c
+int			ordered_acquire(t_philosopher *philo);
+void		ordered_think(t_philosopher *philo);
+int			hierarchy_acquire(t_philosopher *philo);
+t_log_event	fork_event(t_philosopher *philo, int fork);
+
+// fork_waiter.c
+int			waiter_acquire(t_philosopher *philo);
+void		waiter_release(t_philosopher *philo);
+
+// fork_waiter_precedence.c
+int			waiter_precedes(long ticket_a, int seat_a, long ticket_b,
+				int seat_b);
+int			waiter_can_eat(t_waiter *waiter, t_philosopher *philo);
+
+// fork_waiter_setup.c
+int			waiter_init(t_simulation *sim);
+size_t		waiter_size(t_simulation *sim);
+int			priority_init(t_simulation *sim);
+void		waiter_cancel(t_simulation *sim);
+void		waiter_destroy(t_simulation *sim);
+
+// fork_chandy.c
+int			chandy_acquire(t_philosopher *philo);
+void		chandy_release(t_philosopher *philo);
+
+// fork_chandy_setup.c
+int			chandy_init(t_simulation *sim);
+size_t		chandy_size(t_simulation *sim);
+void		chandy_cancel(t_simulation *sim);
+void		chandy_destroy(t_simulation *sim);
+
+// fork_schedule.c
+int			schedule_acquire(t_philosopher *philo);
+void		schedule_release(t_philosopher *philo);
+void		schedule_leave(t_philosopher *philo);
+
+// fork_schedule_setup.c
+int			schedule_init(t_simulation *sim);
+size_t		schedule_size(t_simulation *sim);
+void		schedule_destroy(t_simulation *sim);
 
 // philo.c
 void		*philosopher_lifecycle(void *arg);
 
+// think.c
+long long	think_until(t_philosopher *philo, long long now);
+long long	think_next_wake(t_philosopher *philo, long long now,
+				long long until);
+void		adaptive_think(t_philosopher *philo, long long now);
+
+// timer_wheel.c
+void		timer_wheel_init(t_timer_wheel *wheel, long long now);
+void		timer_wheel_add(t_timer_wheel *wheel, t_timer *timer,
+				long long expires);
+void		timer_wheel_remove(t_timer_wheel *wheel, t_timer *timer);
+int			timer_wheel_event(const t_timer_wheel *wheel, long long *tick);
+
+// timer_wheel_expire.c
+t_timer		*timer_wheel_pop(t_timer_wheel *wheel, long long now);
+long long	timer_wheel_next(const t_timer_wheel *wheel, long long now);
+
+// pool.c
+int			pool_worker_count(t_simulation *sim);
+int			pool_init(t_simulation *sim);
+
+// log_file.c
+long long	log_direct(t_simulation *sim, int philo_id, t_log_event event);
+
+// metrics.c
+int			metrics_start(t_simulation *sim);
+void		metrics_stop(t_simulation *sim);
+
+// metrics_sample.c
+void		metrics_sample(t_simulation *sim, t_metrics_sample *sample);
+int			metrics_write(t_simulation *sim, const t_metrics_sample *sample);
+
+// virtual.c
+int			virtual_start(t_simulation *sim);
+void		virtual_run(t_simulation *sim);
+
+// pool_run.c
+int			pool_start(t_simulation *sim);
+void		pool_join(t_simulation *sim);
+
+// pool_crew.c
+int			crew_start(t_simulation *sim, t_crew *crew);
+void		crew_wait(t_crew *crew);
+void		crew_destroy(t_crew *crew);
+
+// pool_worker.c
+void		pool_deliver(t_worker *from, t_task *task);
+void		*pool_worker_routine(void *arg);
+
+// pool_fork.c
+int			task_take_forks(t_task *task, int granted);
+void		task_release_forks(t_task *task);
+
+// pool_task.c
+void		task_hungry(t_task *task, long long now);
+void		task_start(t_task *task, long long start_time);
+void		task_resume(t_task *task);
+void		task_expire(t_timer *timer, long long now);
+
+// pool_think.c
+void		task_think(t_task *task, long long now);
+void		task_keep_thinking(t_task *task, long long now);
+
+// pool_death.c
+void		task_arm_death(t_task *task, long long last_meal);
+void		task_starve(t_task *task, long long now);
+
+// free.c
+void		join_simulation_threads(t_simulation *sim);
+void		release_simulation_resources(t_simulation *sim);
+void		cleanup_simulation_resources(t_simulation *sim);
 void		monitor_simulation_and_cleanup(t_simulation *sim);
+void		abort_simulation(t_simulation *sim);
+
+// bench_stats.c
+void		bench_collect(t_simulation *sim, t_bench_result *result,
+				long long elapsed_ns);
+
+// bench.c
+int			bench_run(const t_options *options, const t_bench_config *config,
+				t_bench_result *result);
+int			run_benchmark(const t_options *options);
+
+// decode_block.c
+unsigned long long	decode_load_le(const unsigned char *in, int bytes);
+int			decode_block(t_logger *logger, const unsigned char *header,
+				const unsigned char *payload);
+
+// decode_slots.c
+int			decode_slots(int fd, t_logger *logger);
+
+// batch.c
+int			run_batch(const t_options *options);
+
+// sweep.c
+int			run_sweep(const t_options *options, int argc, char *argv[]);
+
+// perf.c
+int			run_perf(const t_options *options);
 
 #endif
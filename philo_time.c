@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_time.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:42:56 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:53:32 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Gets the current time in nanoseconds.
+ * 
+ * The time comes from PHILO_CLOCK_ID, which is CLOCK_MONOTONIC unless the
+ * build selects CLOCK_MONOTONIC_COARSE (see philo.h). Both count from an
+ * arbitrary fixed point and are never stepped by NTP or by setting the wall
+ * clock, so a clock adjustment can no longer fake a starvation. Every timer
+ * in the simulation uses this single time base; only the output is scaled
+ * to milliseconds.
+ * 
+ * @return The current monotonic time in nanoseconds.
+ */
+long long	get_time_ns(void)
+{
+	struct timespec	now;
+
+	clock_gettime(PHILO_CLOCK_ID, &now);
+	return (now.tv_sec * NS_PER_SEC + now.tv_nsec);
+}
+
+/**
+ * @brief Converts a duration in milliseconds to nanoseconds.
+ * 
+ * @param milliseconds The duration to convert (e.g. `time_to_eat`).
+ * @return The same duration in nanoseconds.
+ */
+long long	ms_to_ns(long long milliseconds)
+{
+	return (milliseconds * NS_PER_MS);
+}
+
+/**
+ * @brief Splits a nanosecond time value into a `struct timespec`.
+ * 
+ * @param nanoseconds Time value from get_time_ns().
+ * @param out Receives the seconds and nanoseconds parts.
+ */
+void	ns_to_timespec(long long nanoseconds, struct timespec *out)
+{
+	out->tv_sec = nanoseconds / NS_PER_SEC;
+	out->tv_nsec = nanoseconds % NS_PER_SEC;
+}
+
+/**
+ * @brief Initializes a condition variable whose timed waits use the
+ *        monotonic clock.
+ * 
+ * pthread_cond_timedwait() measures its absolute timeout against the wall
+ * clock by default; this binds it to CLOCK_MONOTONIC so that deadlines taken
+ * from get_time_ns() can be passed to it directly. The coarse clock shares
+ * the same time base, so it works with both clock selections.
+ * 
+ * @param cond The condition variable to initialize.
+ * @return Returns SUCCESS (=0) on success, otherwise FAILURE (=1).
+ */
+int	init_monotonic_cond(pthread_cond_t *cond)
+{
+	pthread_condattr_t	attr;
+	int					status;
+
+	if (pthread_condattr_init(&attr) != SUCCESS)
+		return (FAILURE);
+	status = pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	if (status == SUCCESS)
+		status = pthread_cond_init(cond, &attr);
+	pthread_condattr_destroy(&attr);
+	if (status != SUCCESS)
+		return (FAILURE);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Returns the simulation's current time.
+ * 
+ * The simulated clock with `--engine=virtual`, get_time_ns() otherwise,
+ * so code shared by the engines (the pool's tasks) stamps meals and
+ * events on the right time base.
+ * 
+ * @param sim The simulation.
+ * @return The current time in nanoseconds.
+ */
+long long	simulation_time(t_simulation *sim)
+{
+	if (sim->options.engine == ENGINE_VIRTUAL)
+		return (sim->virtual_now);
+	return (get_time_ns());
+}
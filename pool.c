@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:53:12 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:53:32 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Returns the number of workers the pool engine will use.
+ * 
+ * `--workers=N` if given, otherwise one per online CPU, and never more
+ * workers than philosophers. `--engine=virtual` runs a single one.
+ * 
+ * @param sim A configured simulation.
+ * @return The worker count, at least 1.
+ */
+int	pool_worker_count(t_simulation *sim)
+{
+	long	count;
+
+	count = sim->options.workers;
+	if (sim->options.engine == ENGINE_VIRTUAL)
+		count = 1;
+	if (count <= 0)
+		count = sysconf(_SC_NPROCESSORS_ONLN);
+	if (count > sim->philosopher_count)
+		count = sim->philosopher_count;
+	if (count < 1)
+		count = 1;
+	return ((int)count);
+}
+
+/**
+ * @brief Sets up one worker and the tasks of its block of philosophers.
+ * 
+ * Worker `w` of `W` runs philosophers `[w * N / W, (w + 1) * N / W)` and
+ * all of them log into the worker's ring, which keeps every ring
+ * single-producer.
+ * 
+ * @param sim The simulation being prepared.
+ * @param index Index of the worker.
+ */
+static void	init_worker(t_simulation *sim, int index)
+{
+	t_worker	*worker;
+	t_task		*task;
+	int			i;
+
+	worker = &sim->pool.workers[index];
+	atomic_init(&worker->inbox, NULL);
+	atomic_init(&worker->wake, 0);
+	atomic_init(&worker->parked, FALSE);
+	worker->simulation = sim;
+	worker->first = (long long)index * sim->philosopher_count
+		/ sim->pool.worker_count;
+	worker->end = (long long)(index + 1) * sim->philosopher_count
+		/ sim->pool.worker_count;
+	i = worker->first - 1;
+	while (++i < worker->end)
+	{
+		task = &sim->pool.tasks[i];
+		memset(task, 0, sizeof(t_task));
+		task->philo = &sim->philosophers[i];
+		task->worker = worker;
+		task->death.kind = TIMER_DEATH;
+		sim->philosophers[i].log_ring = &sim->logger.rings[index];
+	}
+}
+
+/**
+ * @brief Carves the workers and one task per philosopher out of the
+ *        simulation's arena.
+ * 
+ * The logger must have been created with pool_worker_count() rings and the
+ * philosophers must already be set up.
+ * 
+ * @param sim The simulation being prepared.
+ * @return Returns SUCCESS (=0) on success, otherwise prints an error message
+ *         and returns an error code.
+ */
+int	pool_init(t_simulation *sim)
+{
+	int	i;
+
+	sim->pool.worker_count = pool_worker_count(sim);
+	sim->pool.workers = arena_alloc(&sim->arena,
+			sizeof(t_worker) * sim->pool.worker_count);
+	sim->pool.tasks = arena_alloc(&sim->arena,
+			sizeof(t_task) * sim->philosopher_count);
+	if (!sim->pool.workers || !sim->pool.tasks)
+		return (print_error("Error: Memory allocation failed\n"));
+	i = -1;
+	while (++i < sim->pool.worker_count)
+		init_worker(sim, i);
+	return (SUCCESS);
+}
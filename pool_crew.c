@@ -0,0 +1,166 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_crew.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 18:04:27 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/15 18:04:27 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Main loop of a crew thread: runs its worker in every run that
+ *        has one and parks in between.
+ * 
+ * Every member counts down `busy` once per run, whether it had a worker
+ * to run or not, so the crew is idle once `busy` is 0.
+ * 
+ * @param arg Pointer to the t_crew_member.
+ * @return NULL once the crew is destroyed.
+ */
+static void	*crew_routine(void *arg)
+{
+	t_crew_member	*member;
+	t_crew			*crew;
+	t_simulation	*sim;
+
+	member = (t_crew_member *)arg;
+	crew = member->crew;
+	while (TRUE)
+	{
+		while (atomic_load(&crew->generation) == member->generation)
+			futex_wait(&crew->generation, member->generation);
+		member->generation = atomic_load(&crew->generation);
+		sim = crew->simulation;
+		if (!sim)
+			return (NULL);
+		if (member->index < sim->pool.worker_count)
+		{
+			affinity_pin_self(sim, member->index, sim->pool.worker_count);
+			pool_worker_routine(&sim->pool.workers[member->index]);
+		}
+		if (atomic_fetch_sub(&crew->busy, 1) == 1)
+			futex_wake_all(&crew->busy);
+	}
+}
+
+/**
+ * @brief Creates crew threads until there is one per worker of `sim`.
+ * 
+ * Threads are created like pool_start()'s, except that a `--stack-size`
+ * stack comes from pthread: the arena is emptied between runs, and the
+ * crew outlives them.
+ * 
+ * @param sim A simulation about to be launched.
+ * @param crew The crew.
+ * @return SUCCESS, or FAILURE after printing an error message.
+ */
+static int	crew_grow(t_simulation *sim, t_crew *crew)
+{
+	t_crew_member	**members;
+	t_crew_member	*member;
+	pthread_attr_t	attr;
+	int				status;
+
+	members = realloc(crew->members,
+			sizeof(t_crew_member *) * sim->pool.worker_count);
+	if (!members)
+		return (print_error("Error: Memory allocation failed\n"));
+	crew->members = members;
+	while (crew->count < sim->pool.worker_count)
+	{
+		member = calloc(1, sizeof(t_crew_member));
+		if (!member)
+			return (print_error("Error: Memory allocation failed\n"));
+		member->crew = crew;
+		member->index = crew->count;
+		member->generation = atomic_load(&crew->generation);
+		status = thread_attr_init(sim, crew->count, sim->pool.worker_count,
+				&attr);
+		if (status == SUCCESS && sim->stack_size)
+			pthread_attr_setstacksize(&attr, sim->stack_size);
+		if (status == SUCCESS)
+		{
+			status = pthread_create(&member->thread, &attr, crew_routine,
+					member);
+			pthread_attr_destroy(&attr);
+			if (status != SUCCESS)
+				print_error("Error: Failed to create worker thread.\n");
+		}
+		if (status != SUCCESS)
+		{
+			free(member);
+			return (FAILURE);
+		}
+		members[crew->count++] = member;
+	}
+	return (SUCCESS);
+}
+
+/**
+ * @brief Starts the workers of a `--batch` run on the parked crew,
+ *        creating only the threads earlier runs did not need.
+ * 
+ * The run is published before the generation is bumped, and the previous
+ * run's crew_wait() guarantees no member still reads the old one.
+ * 
+ * @param sim A simulation about to be launched.
+ * @param crew The batch's crew.
+ * @return SUCCESS, or FAILURE after printing an error message.
+ */
+int	crew_start(t_simulation *sim, t_crew *crew)
+{
+	if (crew->count < sim->pool.worker_count
+		&& crew_grow(sim, crew) != SUCCESS)
+		return (FAILURE);
+	crew->simulation = sim;
+	atomic_store(&crew->busy, crew->count);
+	atomic_fetch_add(&crew->generation, 1);
+	futex_wake_all(&crew->generation);
+	sim->launched = sim->pool.worker_count;
+	return (SUCCESS);
+}
+
+/**
+ * @brief Waits until every member is parked again after a run.
+ * 
+ * @param crew The crew.
+ */
+void	crew_wait(t_crew *crew)
+{
+	int	busy;
+
+	busy = atomic_load(&crew->busy);
+	while (busy != 0)
+	{
+		futex_wait(&crew->busy, busy);
+		busy = atomic_load(&crew->busy);
+	}
+}
+
+/**
+ * @brief Tells every parked member to quit and joins it.
+ * 
+ * @param crew A crew whose last run was waited for; may be empty.
+ */
+void	crew_destroy(t_crew *crew)
+{
+	int	i;
+
+	crew->simulation = NULL;
+	atomic_fetch_add(&crew->generation, 1);
+	futex_wake_all(&crew->generation);
+	i = -1;
+	while (++i < crew->count)
+	{
+		pthread_join(crew->members[i]->thread, NULL);
+		free(crew->members[i]);
+	}
+	free(crew->members);
+	crew->members = NULL;
+	crew->count = 0;
+}
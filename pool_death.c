@@ -0,0 +1,54 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_death.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:58:06 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:56:27 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief (Re)arms a task's death deadline after a meal or at the start.
+ * 
+ * The pool engine needs no deadline heap: the worker that runs a
+ * philosopher also owns their deadline, so a meal simply moves the timer
+ * in O(1) and a deadline that fires is always current.
+ * 
+ * @param task The task that starts eating or starts the simulation.
+ * @param last_meal Start of the meal (or of the simulation), in ns.
+ */
+void	task_arm_death(t_task *task, long long last_meal)
+{
+	timer_wheel_remove(&task->worker->wheel, &task->death);
+	timer_wheel_add(&task->worker->wheel, &task->death,
+		last_meal + ms_to_ns(task->philo->simulation->time_to_die));
+}
+
+/**
+ * @brief Handles a death deadline that has expired: the task starved.
+ * 
+ * Several workers may see a deadline expire at the same time; only the one
+ * whose end_simulation() call ended the simulation reports its death, which
+ * keeps a single death line. The monitor is woken so the main thread can
+ * start the cleanup.
+ * 
+ * @param task The task whose death deadline fired.
+ * @param now Current time in nanoseconds.
+ */
+void	task_starve(t_task *task, long long now)
+{
+	t_simulation	*sim;
+
+	sim = task->philo->simulation;
+	if (!end_simulation(sim))
+		return ;
+	sim->death_latency_ns = now - task->death.expires;
+	sim->death_time = now;
+	log_philo_status(task->philo, LOG_DIED);
+	notify_monitor(sim);
+}
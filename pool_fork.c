@@ -0,0 +1,159 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_fork.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:53:34 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:29:20 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Returns the n-th fork a task acquires.
+ * 
+ * Same order as the ordered fork strategy (fork_ordered.c), which the pool
+ * uses whatever `--strategy` says: odd-numbered philosophers take the left
+ * fork first, even-numbered ones the right fork first.
+ * 
+ * @param task The acquiring task.
+ * @param n 0 for the first fork, 1 for the second.
+ * @param event Receives LOG_TAKEN_LEFT_FORK or LOG_TAKEN_RIGHT_FORK.
+ * @return Index of the fork.
+ */
+static int	task_fork(t_task *task, int n, t_log_event *event)
+{
+	if ((task->philo->id % 2 == 1) == (n == 0))
+	{
+		*event = LOG_TAKEN_LEFT_FORK;
+		return (task->philo->left_fork_index);
+	}
+	*event = LOG_TAKEN_RIGHT_FORK;
+	return (task->philo->right_fork_index);
+}
+
+/**
+ * @brief Takes a fork, or queues behind its holder.
+ * 
+ * A fork is shared by exactly two philosophers, so at most one can be
+ * waiting for it and the waiter is always the holder's neighbour:
+ * FORK_FREE -> FORK_HELD takes it, FORK_HELD -> FORK_CONTENDED queues.
+ * 
+ * @param state The fork's state word.
+ * @return TRUE (=1) if the fork was taken, FALSE (=0) if the caller now
+ *         waits for it to be handed over.
+ */
+static int	fork_request(_Atomic int *state)
+{
+	int	expected;
+
+	while (TRUE)
+	{
+		expected = FORK_FREE;
+		if (atomic_compare_exchange_weak(state, &expected, FORK_HELD))
+			return (TRUE);
+		if (expected == FORK_HELD
+			&& atomic_compare_exchange_weak(state, &expected, FORK_CONTENDED))
+			return (FALSE);
+	}
+}
+
+/**
+ * @brief Announces the fork the task has just obtained.
+ * 
+ * PHILO_STATS builds record how long the task waited for it, up to the
+ * timestamp of the announcement; other builds skip a muted pickup without
+ * reading the clock.
+ * 
+ * @param task The task that took its next fork.
+ */
+static void	task_took_fork(t_task *task)
+{
+	t_log_event	event;
+	long long	now;
+
+	task_fork(task, task->forks_held++, &event);
+	if (!PHILO_STATS && is_event_muted(task->philo->simulation, event))
+		return ;
+	now = print_timestamp_and_philo_status_msg(task->philo, event);
+	if (PHILO_STATS)
+		stats_record_fork_wait(task->philo->stats, event,
+			now - task->fork_request);
+}
+
+/**
+ * @brief Takes the task's forks in order, without ever blocking.
+ * 
+ * The task stops at the first fork that is held and is resumed through
+ * pool_deliver() once its holder releases it; the fork then already
+ * belongs to the task. This mirrors blocking on the fork mutexes, including
+ * the FIFO hand-over, while the worker goes on running other tasks.
+ * 
+ * @param task A hungry task.
+ * @param granted TRUE (=1) if the task was just handed its pending fork.
+ * @return TRUE (=1) once the task holds both forks, FALSE (=0) if it waits.
+ */
+int	task_take_forks(t_task *task, int granted)
+{
+	t_log_event	event;
+	int			fork;
+
+	if (granted)
+		task_took_fork(task);
+	while (task->forks_held < 2)
+	{
+		fork = task_fork(task, task->forks_held, &event);
+		if (PHILO_STATS)
+			task->fork_request = simulation_time(task->philo->simulation);
+		if (!fork_request(&task->philo->simulation->seats[fork].fork_state))
+		{
+			atomic_fetch_add_explicit(
+				&task->philo->simulation->seats[fork].fork.waits, 1,
+				memory_order_relaxed);
+			return (FALSE);
+		}
+		task_took_fork(task);
+	}
+	return (TRUE);
+}
+
+/**
+ * @brief Releases both forks, handing each one to a waiting neighbour.
+ * 
+ * FORK_HELD -> FORK_FREE if nobody waits. Otherwise the state stays
+ * FORK_HELD, now on behalf of the neighbour, who is resumed.
+ * 
+ * @param task A task holding both forks.
+ */
+void	task_release_forks(t_task *task)
+{
+	t_simulation	*sim;
+	int				fork;
+	int				other;
+	int				expected;
+	int				n;
+
+	sim = task->philo->simulation;
+	n = -1;
+	while (++n < 2)
+	{
+		fork = task->philo->left_fork_index;
+		other = (fork + sim->philosopher_count - 1) % sim->philosopher_count;
+		if (n == 1)
+		{
+			fork = task->philo->right_fork_index;
+			other = fork;
+		}
+		expected = FORK_HELD;
+		if (!atomic_compare_exchange_strong(&sim->seats[fork].fork_state,
+				&expected, FORK_FREE))
+		{
+			atomic_store(&sim->seats[fork].fork_state, FORK_HELD);
+			pool_deliver(task->worker, &sim->pool.tasks[other]);
+		}
+	}
+	task->forks_held = 0;
+}
@@ -0,0 +1,77 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_run.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:53:12 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:51:11 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Starts every worker of the pool engine.
+ * 
+ * Each worker parks at the start gate, then initializes its timer wheel
+ * and starts its own tasks, so a task is only ever touched by the worker
+ * that owns it. With `--pin`
+ * worker `w` is pinned like thread `w` of affinity_pin(). A `--batch`
+ * run hands its workers to the batch's parked crew (crew_start()).
+ * 
+ * @param sim A simulation about to be launched.
+ * @return Returns SUCCESS (=0) if every worker was created, otherwise prints
+ *         an error message and returns an error code.
+ */
+int	pool_start(t_simulation *sim)
+{
+	pthread_attr_t	attr;
+	int				status;
+	int				i;
+
+	if (sim->crew)
+		return (crew_start(sim, sim->crew));
+	i = -1;
+	while (++i < sim->pool.worker_count)
+	{
+		if (thread_attr_init(sim, i, sim->pool.worker_count, &attr)
+			!= SUCCESS)
+			return (FAILURE);
+		status = pthread_create(&sim->pool.workers[i].thread, &attr,
+				pool_worker_routine, &sim->pool.workers[i]);
+		pthread_attr_destroy(&attr);
+		if (status != SUCCESS)
+			return (print_error("Error: Failed to create worker thread.\n"));
+		sim->launched++;
+	}
+	return (SUCCESS);
+}
+
+/**
+ * @brief Wakes every started worker of an ended simulation and joins it.
+ * 
+ * end_simulation() only wakes threads sleeping on `simulation_ended`, while
+ * a parked worker sleeps on its own `wake` word until its next timer, so it
+ * is woken here. The threads of a crew are not joined but waited for
+ * until they are parked for the next run.
+ * 
+ * @param sim A simulation that has been flagged as ended.
+ */
+void	pool_join(t_simulation *sim)
+{
+	int	i;
+
+	i = -1;
+	while (++i < sim->launched)
+	{
+		atomic_fetch_add(&sim->pool.workers[i].wake, 1);
+		futex_wake_all(&sim->pool.workers[i].wake);
+	}
+	if (sim->crew)
+		crew_wait(sim->crew);
+	i = -1;
+	while (!sim->crew && ++i < sim->launched)
+		pthread_join(sim->pool.workers[i].thread, NULL);
+}
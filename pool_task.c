@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_task.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:53:46 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:11:00 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Starts a meal once the task holds both forks.
+ * 
+ * @param task The task that holds both forks.
+ */
+static void	task_eat(t_task *task)
+{
+	t_philosopher	*philo;
+	long long		now;
+
+	philo = task->philo;
+	now = print_timestamp_and_philo_status_msg(philo, LOG_EATING);
+	record_meal(philo, now);
+	task_arm_death(task, now);
+	if (PHILO_STATS)
+		histogram_record(&philo->stats->fork_wait, now - task->hunger_start);
+	task->state = TASK_EATING;
+	timer_wheel_add(&task->worker->wheel, &task->timer,
+		now + ms_to_ns(philo->simulation->time_to_eat));
+}
+
+/**
+ * @brief Makes the task hungry and lets it take whatever forks it can.
+ * 
+ * @param task The task that finished thinking.
+ * @param now Current time in nanoseconds.
+ */
+void	task_hungry(t_task *task, long long now)
+{
+	task->state = TASK_HUNGRY;
+	task->hunger_start = now;
+	task->forks_held = 0;
+	if (task_take_forks(task, FALSE))
+		task_eat(task);
+}
+
+/**
+ * @brief Runs the first step of a task on its worker.
+ * 
+ * Arms the death deadline, then mirrors the start of
+ * philosopher_lifecycle(): the task thinks (task_think()), which lets
+ * even-numbered philosophers leave the forks to their odd neighbours, or
+ * with `--think=fixed` makes them think for the same stagger while the
+ * others get hungry right away. A lone philosopher takes their only fork
+ * and waits for death.
+ * 
+ * @param task The task to start.
+ * @param start_time Simulation start time in nanoseconds.
+ */
+void	task_start(t_task *task, long long start_time)
+{
+	t_simulation	*sim;
+
+	sim = task->philo->simulation;
+	task_arm_death(task, start_time);
+	if (sim->philosopher_count == 1)
+	{
+		log_philo_status(task->philo, LOG_TAKEN_FORK);
+		return ;
+	}
+	if (sim->options.think == THINK_ADAPTIVE)
+		task_think(task, start_time);
+	else if (task->philo->id % 2 == 0)
+	{
+		task->state = TASK_THINKING;
+		timer_wheel_add(&task->worker->wheel, &task->timer,
+			start_time + sim->time_to_eat / 2 * NS_PER_US);
+	}
+	else
+		task_hungry(task, start_time);
+}
+
+/**
+ * @brief Continues a task that has been handed the fork it waited for.
+ * 
+ * @param task A hungry task.
+ */
+void	task_resume(t_task *task)
+{
+	if (task_take_forks(task, TRUE))
+		task_eat(task);
+}
+
+/**
+ * @brief Advances the task whose timer has expired.
+ * 
+ * A death deadline is handed to task_starve(). Otherwise:
+ * 
+ * 1. End of a meal: release the forks and sleep for `time_to_sleep` from
+ *    now, exactly like philo_spend_time() does after a late wake-up.
+ * 2. End of a sleep: think (task_think()).
+ * 3. End of a think timer: go on thinking or get hungry
+ *    (task_keep_thinking()).
+ * 
+ * PHILO_STATS builds record how late each meal and sleep ended.
+ * 
+ * @param timer The timer that fired, either a task's `timer` or `death`.
+ * @param now Current time in nanoseconds.
+ */
+void	task_expire(t_timer *timer, long long now)
+{
+	t_simulation	*sim;
+	t_task			*task;
+
+	if (timer->kind == TIMER_DEATH)
+	{
+		task_starve((t_task *)((char *)timer - offsetof(t_task, death)), now);
+		return ;
+	}
+	task = (t_task *)timer;
+	sim = task->philo->simulation;
+	if (PHILO_STATS && task->state != TASK_THINKING)
+		stats_record_sleep(task->philo->stats, 0, now - task->timer.expires);
+	if (task->state == TASK_EATING)
+	{
+		task_release_forks(task);
+		log_philo_status(task->philo, LOG_SLEEPING);
+		task->state = TASK_SLEEPING;
+		timer_wheel_add(&task->worker->wheel, &task->timer,
+			now + ms_to_ns(sim->time_to_sleep));
+	}
+	else if (task->state == TASK_SLEEPING)
+	{
+		log_philo_status(task->philo, LOG_THINKING);
+		task_think(task, now);
+	}
+	else
+		task_keep_thinking(task, now);
+}
@@ -0,0 +1,64 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_think.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 14:06:31 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/15 14:06:31 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Starts a task's thinking, the pool's counterpart of the think
+ *        step of philosopher_lifecycle().
+ * 
+ * With `--think=adaptive` the task runs adaptive_think() as timers: it
+ * yields until think_until() for as long as a neighbour is needier,
+ * checking again every THINK_SLICE_NS, so every engine thinks alike.
+ * With `--think=fixed` it thinks for the ordered strategy's 100 us with an
+ * odd count, and not at all otherwise.
+ * 
+ * @param task A task that has just finished sleeping, or is starting.
+ * @param now Current time in nanoseconds.
+ */
+void	task_think(t_task *task, long long now)
+{
+	t_simulation	*sim;
+
+	sim = task->philo->simulation;
+	task->state = TASK_THINKING;
+	if (sim->options.think == THINK_ADAPTIVE)
+	{
+		task->think_until = think_until(task->philo, now);
+		task_keep_thinking(task, now);
+	}
+	else if (sim->philosopher_count % 2 == 1)
+		timer_wheel_add(&task->worker->wheel, &task->timer,
+			now + 100 * NS_PER_US);
+	else
+		task_hungry(task, now);
+}
+
+/**
+ * @brief Ends a think timer: thinks on for another slice while the
+ *        adaptive yield lasts, and gets hungry otherwise.
+ * 
+ * @param task A thinking task whose timer expired, or that just started.
+ * @param now Current time in nanoseconds.
+ */
+void	task_keep_thinking(t_task *task, long long now)
+{
+	long long	wake;
+
+	wake = -1;
+	if (task->philo->simulation->options.think == THINK_ADAPTIVE)
+		wake = think_next_wake(task->philo, now, task->think_until);
+	if (wake < 0)
+		task_hungry(task, now);
+	else
+		timer_wheel_add(&task->worker->wheel, &task->timer, wake);
+}
@@ -0,0 +1,150 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_worker.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:53:21 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:51:11 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Resumes a task that has just been handed a fork.
+ * 
+ * A task of the calling worker is resumed in place. A task of another
+ * worker is pushed onto that worker's inbox, and the worker is woken if it
+ * is parked. The push is a sequentially consistent CAS and `parked` is
+ * read after it, which pairs with worker_wait(): either the pusher sees
+ * the worker parked, or the worker sees the pushed task.
+ * 
+ * @param from The worker releasing the fork.
+ * @param task The task waiting for it.
+ */
+void	pool_deliver(t_worker *from, t_task *task)
+{
+	t_worker	*owner;
+	t_task		*head;
+
+	owner = task->worker;
+	if (owner == from)
+	{
+		task_resume(task);
+		return ;
+	}
+	head = atomic_load_explicit(&owner->inbox, memory_order_relaxed);
+	task->inbox_next = head;
+	while (!atomic_compare_exchange_weak(&owner->inbox, &head, task))
+		task->inbox_next = head;
+	if (atomic_load(&owner->parked))
+	{
+		atomic_fetch_add(&owner->wake, 1);
+		futex_wake_all(&owner->wake);
+	}
+}
+
+/**
+ * @brief Resumes every task other workers have handed a fork to.
+ * 
+ * @param worker The calling worker.
+ */
+static void	drain_inbox(t_worker *worker)
+{
+	t_task	*task;
+	t_task	*next;
+
+	task = atomic_exchange_explicit(&worker->inbox, NULL,
+			memory_order_acquire);
+	while (task)
+	{
+		next = task->inbox_next;
+		task_resume(task);
+		task = next;
+	}
+}
+
+/**
+ * @brief Fires every expired timer of the worker's wheel.
+ * 
+ * Stops early once the simulation has ended, e.g. after a death.
+ * 
+ * @param worker The calling worker.
+ */
+static void	run_timers(t_worker *worker)
+{
+	t_timer		*timer;
+	long long	now;
+
+	now = get_time_ns();
+	timer = timer_wheel_pop(&worker->wheel, now);
+	while (timer && !is_simulation_finished(worker->simulation))
+	{
+		task_expire(timer, now);
+		timer = timer_wheel_pop(&worker->wheel, now);
+	}
+}
+
+/**
+ * @brief Parks the worker until its next timer or until it is woken.
+ * 
+ * The worker sleeps on its `wake` futex with the absolute deadline from
+ * timer_wheel_next(). It does not sleep if a task arrived in its inbox or a
+ * wake-up happened since `seen` was read.
+ * 
+ * @param worker The calling worker.
+ * @param seen Value of `wake` read before the inbox was last drained.
+ */
+static void	worker_wait(t_worker *worker, int seen)
+{
+	long long	now;
+	long long	deadline;
+
+	now = get_time_ns();
+	deadline = timer_wheel_next(&worker->wheel, now);
+	if (deadline <= now)
+		return ;
+	if (deadline - now > POOL_IDLE_WAIT_NS)
+		deadline = now + POOL_IDLE_WAIT_NS;
+	atomic_store(&worker->parked, TRUE);
+	if (!atomic_load(&worker->inbox)
+		&& !is_simulation_finished(worker->simulation))
+		futex_wait_until(&worker->wake, seen, deadline);
+	atomic_store(&worker->parked, FALSE);
+}
+
+/**
+ * @brief Main loop of a pool worker.
+ * 
+ * Waits for the start gate and starts the worker's tasks, then repeatedly resumes handed-over tasks,
+ * fires expired timers and parks until there is something to do, until
+ * the simulation ends. Nothing here blocks on a fork: a task that cannot
+ * take one is resumed when its neighbour releases it.
+ * 
+ * @param arg Pointer to the t_worker.
+ * @return NULL on thread completion.
+ */
+void	*pool_worker_routine(void *arg)
+{
+	t_worker	*worker;
+	int			seen;
+	int			i;
+
+	worker = (t_worker *)arg;
+	start_gate_wait(worker->simulation);
+	timer_wheel_init(&worker->wheel, worker->simulation->sim_start_time);
+	i = worker->first - 1;
+	while (++i < worker->end)
+		task_start(&worker->simulation->pool.tasks[i],
+			worker->simulation->sim_start_time);
+	while (!is_simulation_finished(worker->simulation))
+	{
+		seen = atomic_load(&worker->wake);
+		drain_inbox(worker);
+		run_timers(worker);
+		worker_wait(worker, seen);
+	}
+	return (NULL);
+}
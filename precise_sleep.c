@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   precise_sleep.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:43:42 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:11:00 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Hints the CPU that the caller is busy-waiting.
+ * 
+ * Uses `pause` on x86 and `yield` on ARM, which lowers power use and frees
+ * pipeline resources for a sibling hyperthread while spinning.
+ */
+void	cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+	__asm__ __volatile__ ("yield");
+#endif
+}
+
+/**
+ * @brief Sleeps until an absolute deadline, returning early if the
+ *        simulation ends.
+ * 
+ * The wait is split in two phases:
+ * 
+ * 1. Bulk: futex wait on `simulation_ended` with an absolute monotonic
+ *    timeout of `deadline - sleep_spin_ns`. The thread costs no CPU, and
+ *    end_simulation() wakes it immediately with a single broadcast.
+ * 2. Tail: spin with cpu_relax() for the last `sleep_spin_ns`, which
+ *    absorbs the kernel's wake-up latency and timer slack.
+ * 
+ * The tail is skipped when the philosophers outnumber the CPUs: their
+ * spins then add up to more CPU time than there is, and every runnable
+ * spinner delays the monitor by a whole time slice, long enough for it
+ * to miss deaths and never end the simulation.
+ * 
+ * PHILO_STATS builds count the futex wake-ups and the oversleep error.
+ * 
+ * @param philo The philosopher who sleeps.
+ * @param now A clock reading the caller has just taken, e.g. the timestamp
+ *            of the transition that started the sleep.
+ * @param deadline Absolute wake-up time in nanoseconds.
+ * @return The last clock reading, at or after `deadline` unless the
+ *         simulation ended first.
+ */
+long long	precise_sleep_until(t_philosopher *philo, long long now,
+	long long deadline)
+{
+	t_simulation	*sim;
+	long			wakeups;
+
+	sim = philo->simulation;
+	wakeups = 0;
+	while (deadline - now > sim->sleep_spin_ns
+		&& !is_simulation_finished(sim))
+	{
+		futex_wait_until(&sim->simulation_ended, FALSE,
+			deadline - sim->sleep_spin_ns);
+		now = get_time_ns();
+		wakeups++;
+	}
+	while (now < deadline && !is_simulation_finished(sim))
+	{
+		cpu_relax();
+		now = get_time_ns();
+	}
+	if (PHILO_STATS && now >= deadline)
+		stats_record_sleep(philo->stats, wakeups, now - deadline);
+	return (now);
+}
@@ -0,0 +1,126 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sim_arena.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:39:32 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:27:08 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Returns the size of each thread stack carved from the arena.
+ * 
+ * @param sim The simulation.
+ * @return `--stack-size` rounded up to whole pages, or 0 without it.
+ */
+static size_t	stack_size(t_simulation *sim)
+{
+	size_t	page;
+
+	page = sysconf(_SC_PAGESIZE);
+	return (((size_t)sim->options.stack_kb * 1024 + page - 1) & ~(page - 1));
+}
+
+/**
+ * @brief Adds up the arena blocks a simulation will allocate.
+ * 
+ * Must list exactly what setup_philosophers(), monitor_shards_init(),
+ * topology_init(), stats_init(), logger_init(), fork_strategy_init(),
+ * pool_init() and simulation_arena_init() carve out.
+ * 
+ * @param sim A configured simulation.
+ * @param threads Philosopher threads, or workers with `--engine=pool`.
+ * @param capacity Records per log ring.
+ * @return The arena size in bytes.
+ */
+static size_t	simulation_size(t_simulation *sim, int threads,
+		size_t capacity)
+{
+	size_t	count;
+	size_t	size;
+
+	count = sim->philosopher_count;
+	size = arena_span(sizeof(t_philosopher) * count)
+		+ arena_span(sizeof(t_seat) * sim->seat_count)
+		+ arena_span(sizeof(int) * (count + 1))
+		+ arena_span(sizeof(int) * sim->topology.total)
+		+ arena_span(sizeof(t_deadline) * count)
+		+ arena_span(sizeof(t_monitor_shard) * monitor_shard_count(sim))
+		+ arena_span(sizeof(t_log_ring) * threads)
+		+ arena_span(sizeof(t_log_record) * capacity * threads)
+		+ arena_span(sizeof(int) * threads)
+		+ arena_span(LOG_BATCH_BYTES)
+		+ fork_strategy_size(sim);
+	if (!sim->crew)
+		size += arena_span(stack_size(sim) * threads);
+	if (PHILO_STATS)
+		size += arena_span(sizeof(t_philo_stats) * count);
+	if (sim->options.engine != ENGINE_THREADS)
+		size += arena_span(sizeof(t_worker) * threads)
+			+ arena_span(sizeof(t_task) * count);
+	return (size);
+}
+
+/**
+ * @brief Maps the arena that holds all of a simulation's state.
+ * 
+ * The `--topology` is validated and measured first, as its size depends
+ * on the philosophers' rows. A `--batch` hands the arena of the previous
+ * run in, which is reused if it is large enough.
+ * 
+ * Thread stacks, if `--stack-size` was given, come first: the mapping is
+ * page-aligned and every stack a whole number of pages, so each stack is
+ * page-aligned as pthread_attr_setstack() expects. They have no guard page.
+ * A `--batch` crew's threads outlive the run and keep pthread's stacks.
+ * 
+ * @param sim A configured simulation.
+ * @param threads Philosopher threads, or workers with `--engine=pool`.
+ * @param capacity Records per log ring.
+ * @return SUCCESS, or FAILURE after printing an error message.
+ */
+int	simulation_arena_init(t_simulation *sim, int threads, size_t capacity)
+{
+	if (topology_measure(sim) != SUCCESS
+		|| arena_reuse(&sim->arena, simulation_size(sim, threads, capacity))
+		!= SUCCESS)
+		return (FAILURE);
+	sim->stack_size = stack_size(sim);
+	sim->stacks = NULL;
+	if (sim->stack_size && !sim->crew)
+		sim->stacks = arena_alloc(&sim->arena, sim->stack_size * threads);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Prepares the attributes of one of `total` philosopher threads or
+ *        pool workers: its arena stack and, with `--pin`, its CPU.
+ * 
+ * @param sim The simulation.
+ * @param index Index of the thread.
+ * @param total Number of such threads.
+ * @param attr Receives the attributes; the caller destroys them.
+ * @return SUCCESS, or FAILURE after printing an error message.
+ */
+int	thread_attr_init(t_simulation *sim, int index, int total,
+		pthread_attr_t *attr)
+{
+	if (pthread_attr_init(attr) != SUCCESS)
+		return (print_error("Error: Thread attribute setup failed.\n"));
+	if (sim->stacks && pthread_attr_setstack(attr, sim->stacks
+			+ sim->stack_size * index, sim->stack_size) != SUCCESS)
+	{
+		pthread_attr_destroy(attr);
+		return (print_error("Error: Thread stack setup failed.\n"));
+	}
+	if (affinity_pin(sim, index, total, attr) != SUCCESS)
+	{
+		pthread_attr_destroy(attr);
+		return (FAILURE);
+	}
+	return (SUCCESS);
+}
@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   start_gate.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:43:27 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:05:31 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Parks a freshly created thread until the simulation starts.
+ * 
+ * Returns once start_gate_open() has published the start time and every
+ * `last_meal_time`, so the thread never sees a stale deadline.
+ * 
+ * @param sim The simulation being launched.
+ */
+void	start_gate_wait(t_simulation *sim)
+{
+	while (!atomic_load_explicit(&sim->start_gate, memory_order_acquire))
+		futex_wait(&sim->start_gate, FALSE);
+}
+
+/**
+ * @brief Releases every thread parked in start_gate_wait().
+ * 
+ * Also used on a failed launch, after the simulation has been ended, so
+ * the threads already parked can return and be joined.
+ * 
+ * @param sim The simulation being launched.
+ */
+void	start_gate_open(t_simulation *sim)
+{
+	atomic_store_explicit(&sim->start_gate, TRUE, memory_order_release);
+	futex_wake_all(&sim->start_gate);
+}
+
+/**
+ * @brief Starts the simulation clock and releases the parked threads.
+ * 
+ * Called once every thread has been created, so the time spent creating
+ * them no longer counts against the first death deadlines: the start
+ * time and every philosopher's `last_meal_time` are taken right here.
+ * 
+ * @param sim A simulation whose threads are all parked at the gate.
+ * @return Returns SUCCESS (=0), or FAILURE (=1) if the log writer or the
+ *         `--metrics` thread could not be started, in which case the gate
+ *         stays closed.
+ */
+int	start_simulation_clock(t_simulation *sim)
+{
+	int	i;
+
+	sim->sim_start_time = get_time_ns();
+	i = 0;
+	while (i < sim->philosopher_count)
+		atomic_store_explicit(&sim->seats[i++].last_meal_time,
+			sim->sim_start_time, memory_order_relaxed);
+	if (logger_start(&sim->logger, sim->sim_start_time) != SUCCESS
+		|| metrics_start(sim) != SUCCESS)
+		return (FAILURE);
+	start_gate_open(sim);
+	return (SUCCESS);
+}
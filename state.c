@@ -0,0 +1,115 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   state.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:37:42 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:31:58 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Checks if the simulation has finished.
+ * 
+ * Reads the `simulation_ended` flag with acquire ordering, pairing with the
+ * release store in end_simulation(). No lock is taken, so this is cheap enough
+ * to be called between every action of a philosopher.
+ * 
+ * @param sim A pointer to the simulation structure.
+ * @return An integer inicating whether the simulation has ended
+ *         (1 for finished, 0 for not finished.)
+ */
+int	is_simulation_finished(t_simulation *sim)
+{
+	return (atomic_load_explicit(&sim->simulation_ended,
+			memory_order_acquire));
+}
+
+/**
+ * @brief Flags the simulation as ended.
+ * 
+ * Publishes `simulation_ended = TRUE` with release ordering so every thread
+ * that observes the flag through is_simulation_finished() also observes
+ * everything the ending thread wrote before it. The flag doubles as a futex
+ * word, so every philosopher sleeping in precise_sleep_until() or waiting
+ * for a fork (futex_wait_cancellable()) is woken by one broadcast instead
+ * of noticing the end on its next poll or when the fork comes free. The
+ * strategies that wait on condition variables instead are woken through
+ * their `cancel` hook.
+ * 
+ * The flag is set with an exchange, so when several threads detect an end
+ * condition at once exactly one of them learns it came first.
+ * 
+ * @param sim A pointer to the simulation structure.
+ * @return TRUE (=1) if this call ended the simulation, FALSE (=0) if it
+ *         had already ended.
+ */
+int	end_simulation(t_simulation *sim)
+{
+	if (atomic_exchange_explicit(&sim->simulation_ended, TRUE,
+			memory_order_acq_rel))
+		return (FALSE);
+	futex_wake_all(&sim->simulation_ended);
+	if (sim->strategy && sim->strategy->cancel && sim->strategy_data)
+		sim->strategy->cancel(sim);
+	return (TRUE);
+}
+
+/**
+ * @brief Records the start of a meal for a philosopher.
+ * 
+ * Only the philosopher's own thread calls this, so plain release stores are
+ * enough: the monitor reads both fields with acquire loads and never blocks
+ * the eating thread. The meal that satisfies `required_meals` also bumps the
+ * shared satisfied counter, and the last such meal wakes the monitor.
+ * PHILO_STATS builds also record the time since the previous meal start.
+ * 
+ * @param philo The philosopher who started eating.
+ * @param meal_time Timestamp of the meal start in nanoseconds.
+ */
+void	record_meal(t_philosopher *philo, long long meal_time)
+{
+	t_simulation	*sim;
+	int				meals;
+
+	sim = philo->simulation;
+	if (PHILO_STATS)
+		stats_record_meal(philo->stats, meal_time - atomic_load_explicit(
+				&philo->seat->last_meal_time, memory_order_relaxed));
+	atomic_store_explicit(&philo->seat->last_meal_time, meal_time,
+		memory_order_release);
+	meals = atomic_fetch_add_explicit(&philo->seat->meals_eaten, 1,
+			memory_order_release) + 1;
+	if (meals == sim->required_meals
+		&& atomic_fetch_add(&sim->satisfied_count, 1) + 1
+		== sim->philosopher_count)
+		notify_monitor(sim);
+}
+
+/**
+ * @brief Returns the timestamp of a philosopher's last meal start.
+ * 
+ * @param philo The philosopher to inspect.
+ * @return The last meal start time in nanoseconds (acquire load).
+ */
+long long	get_last_meal_time(t_philosopher *philo)
+{
+	return (atomic_load_explicit(&philo->seat->last_meal_time,
+			memory_order_acquire));
+}
+
+/**
+ * @brief Returns the number of meals a philosopher has eaten so far.
+ * 
+ * @param philo The philosopher to inspect.
+ * @return The meal count (acquire load).
+ */
+int	get_meals_eaten(t_philosopher *philo)
+{
+	return (atomic_load_explicit(&philo->seat->meals_eaten,
+			memory_order_acquire));
+}
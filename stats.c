@@ -0,0 +1,41 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:45:53 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:42:30 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Carves one cache-aligned stats slot per philosopher out of the
+ *        simulation's arena.
+ * 
+ * Only PHILO_STATS builds measure anything; otherwise every philosopher's
+ * `stats` pointer stays NULL and nothing is allocated.
+ * 
+ * @param sim A pointer to the simulation whose philosophers are set up.
+ * @return Returns SUCCESS (=0) on success, otherwise prints an error message
+ *         and returns an error code.
+ */
+int	stats_init(t_simulation *sim)
+{
+	int	i;
+
+	sim->stats = NULL;
+	if (!PHILO_STATS)
+		return (SUCCESS);
+	sim->stats = arena_alloc(&sim->arena,
+			sizeof(t_philo_stats) * sim->philosopher_count);
+	if (!sim->stats)
+		return (print_error("Error: Memory allocation failed\n"));
+	i = -1;
+	while (++i < sim->philosopher_count)
+		sim->philosophers[i].stats = &sim->stats[i];
+	return (SUCCESS);
+}
@@ -0,0 +1,119 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats.h                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:45:11 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:23:54 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef STATS_H
+# define STATS_H
+
+# include <stdatomic.h> // _Atomic
+
+/*
+ * Hot-path measurements are compiled in only when PHILO_STATS is non-zero
+ * (`make bench` builds `philo_bench` that way). With the default of 0 every
+ * `if (PHILO_STATS)` block is removed by the compiler.
+ */
+# ifndef PHILO_STATS
+#  define PHILO_STATS 0
+# endif
+
+# define HISTOGRAM_LINEAR 16 // < Values below this get one bucket each.
+# define HISTOGRAM_SUB_BUCKETS 8 // < Buckets per power of two above that.
+# define HISTOGRAM_BUCKETS 512
+
+/**
+ * @brief Log-linear latency histogram (nanoseconds).
+ * 
+ * Each power of two is split into HISTOGRAM_SUB_BUCKETS buckets, so any
+ * reported percentile is within 12.5% of the true value, at a fixed size
+ * and O(1) cost per sample.
+ */
+typedef struct s_histogram
+{
+	unsigned long	counts[HISTOGRAM_BUCKETS];
+	unsigned long	total; // < Number of recorded samples.
+}	t_histogram;
+
+/**
+ * @brief Per-philosopher measurements, written only by the owning thread.
+ * 
+ * Each slot is cache-line aligned, so recording needs neither atomics nor
+ * locks; the slots are read after the threads have been joined.
+ */
+typedef struct s_philo_stats
+{
+	_Alignas(CACHE_LINE_SIZE) long long	left_fork_wait_ns;
+	// ^^^ Time blocked on the left fork's mutex.
+	long long							right_fork_wait_ns;
+	// ^^^ Time blocked on the right fork's mutex.
+	long								left_fork_locks;
+	long								right_fork_locks;
+	long								sleeps; // < Completed sleeps.
+	long								sleep_wakeups; // < Futex wake-ups.
+	long long							oversleep_ns;
+	// ^^^ Total time sleeps returned past their deadline.
+	long long							oversleep_max_ns;
+	long								log_events; // < Logged events.
+	long long							log_ns; // < Time spent logging.
+	long								log_stalls; // < Backoffs on a full ring.
+	long long							hunger_max_ns;
+	// ^^^ Longest time from one meal start (or the start) to the next.
+	t_histogram							fork_wait;
+	// ^^^ Time from starting to acquire the forks to holding both.
+}	t_philo_stats;
+
+/**
+ * @brief One entry of the benchmark matrix, or one configuration of a sweep.
+ */
+typedef struct s_bench_config
+{
+	int	philosopher_count;
+	int	time_to_die;
+	int	time_to_eat;
+	int	time_to_sleep;
+	int	required_meals; // < -1 if unlimited.
+	int	time_limit_ms; // < Length of the run.
+}	t_bench_config;
+
+/**
+ * @brief Measurements of one benchmark run.
+ */
+typedef struct s_bench_result
+{
+	double		meals_per_sec;
+	double		efficiency; // < Share of the theoretical maximum, or -1.
+	int			min_meals; // < Fewest meals eaten by one philosopher.
+	int			max_meals; // < Most meals eaten by one philosopher.
+	double		meals_stddev; // < Standard deviation of the meal counts.
+	double		fairness; // < Jain's index of the meal counts, 1 if even.
+	long long	fork_wait_p50; // < Median fork wait, in ns.
+	long long	fork_wait_p99; // < 99th percentile fork wait, in ns.
+	long long	fork_wait_max; // < Upper bound of the slowest fork wait.
+	long long	hunger_max; // < Longest time between meals in ns, or -1.
+	long long	death_latency; // < Death detection delay in ns, -1 if none.
+	long long	death_time; // < Time of the death from the start, -1 if none.
+}	t_bench_result;
+
+// stats_record.c
+void		stats_record_fork_wait(t_philo_stats *stats, int event,
+				long long wait_ns);
+void		stats_record_sleep(t_philo_stats *stats, long wakeups,
+				long long oversleep_ns);
+void		stats_record_log(t_philo_stats *stats, long long log_ns,
+				int stalls);
+void		stats_record_meal(t_philo_stats *stats, long long hunger_ns);
+
+// histogram.c
+void		histogram_record(t_histogram *histogram, long long value);
+void		histogram_merge(t_histogram *into, const t_histogram *from);
+long long	histogram_percentile(const t_histogram *histogram,
+				double percentile);
+
+#endif
@@ -0,0 +1,135 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats_dump.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:48:01 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 17:48:01 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Adds the counters of one slot to a running total.
+ * 
+ * @param total The accumulating slot.
+ * @param stats The slot to add.
+ */
+static void	accumulate(t_philo_stats *total, const t_philo_stats *stats)
+{
+	total->left_fork_wait_ns += stats->left_fork_wait_ns;
+	total->right_fork_wait_ns += stats->right_fork_wait_ns;
+	total->left_fork_locks += stats->left_fork_locks;
+	total->right_fork_locks += stats->right_fork_locks;
+	total->sleeps += stats->sleeps;
+	total->sleep_wakeups += stats->sleep_wakeups;
+	total->oversleep_ns += stats->oversleep_ns;
+	if (stats->oversleep_max_ns > total->oversleep_max_ns)
+		total->oversleep_max_ns = stats->oversleep_max_ns;
+	total->log_events += stats->log_events;
+	total->log_ns += stats->log_ns;
+	total->log_stalls += stats->log_stalls;
+}
+
+/**
+ * @brief Returns `total / count` in microseconds, or 0 if `count` is 0.
+ * 
+ * @param total_ns Sum of the samples in nanoseconds.
+ * @param count Number of samples.
+ * @return The average in microseconds.
+ */
+static double	average_us(long long total_ns, long count)
+{
+	if (count == 0)
+		return (0.0);
+	return ((double)total_ns / count / NS_PER_US);
+}
+
+/**
+ * @brief Prints one row of the summary table.
+ * 
+ * @param label Philosopher ID, or "all" for the totals.
+ * @param meals Meals eaten.
+ * @param s The counters to print.
+ */
+static void	print_table_row(const char *label, int meals,
+	const t_philo_stats *s)
+{
+	fprintf(stderr, "%6s %6d %10.3f %10.3f %8ld %8ld %9.1f %9.1f %8ld "
+		"%8.2f %6ld\n", label, meals,
+		(double)s->left_fork_wait_ns / NS_PER_MS,
+		(double)s->right_fork_wait_ns / NS_PER_MS, s->sleeps,
+		s->sleep_wakeups, average_us(s->oversleep_ns, s->sleeps),
+		(double)s->oversleep_max_ns / NS_PER_US, s->log_events,
+		average_us(s->log_ns, s->log_events), s->log_stalls);
+}
+
+/**
+ * @brief Prints one philosopher's counters as a JSON object.
+ * 
+ * @param id Philosopher ID, or 0 for the totals.
+ * @param meals Meals eaten.
+ * @param s The counters to print.
+ * @param last TRUE for the final element of the array.
+ */
+static void	print_json_row(int id, int meals, const t_philo_stats *s, int last)
+{
+	fprintf(stderr, "  {\"id\": %d, \"meals\": %d, "
+		"\"left_fork_wait_ns\": %lld, \"right_fork_wait_ns\": %lld, "
+		"\"sleeps\": %ld, \"sleep_wakeups\": %ld, \"oversleep_ns\": %lld, "
+		"\"oversleep_max_ns\": %lld, \"log_events\": %ld, \"log_ns\": %lld, "
+		"\"log_stalls\": %ld}%s\n", id, meals, s->left_fork_wait_ns,
+		s->right_fork_wait_ns, s->sleeps, s->sleep_wakeups, s->oversleep_ns,
+		s->oversleep_max_ns, s->log_events, s->log_ns, s->log_stalls,
+		last ? "" : ",");
+}
+
+/**
+ * @brief Dumps every philosopher's hot-path counters to standard error.
+ * 
+ * Called by cleanup_simulation_resources() in PHILO_STATS builds, after
+ * all threads are joined. The output is a table with one row per
+ * philosopher plus a total ("all"), or with `--stats=json` a JSON array of
+ * the same data where the total has ID 0. Times in the table are: fork
+ * waits in ms, oversleep average/max and logging time per event in us.
+ * 
+ * @param sim A simulation whose threads have been joined.
+ */
+void	stats_dump(t_simulation *sim)
+{
+	t_philo_stats	total;
+	char			label[16];
+	int				meals;
+	int				i;
+
+	memset(&total, 0, sizeof(t_philo_stats));
+	if (sim->options.stats_format != STATS_JSON)
+		fprintf(stderr, "%6s %6s %10s %10s %8s %8s %9s %9s %8s %8s %6s\n",
+			"philo", "meals", "left ms", "right ms", "sleeps", "wakeups",
+			"over us", "max us", "events", "log us", "stalls");
+	else
+		fprintf(stderr, "[\n");
+	meals = 0;
+	i = -1;
+	while (++i < sim->philosopher_count)
+	{
+		accumulate(&total, &sim->stats[i]);
+		meals += get_meals_eaten(&sim->philosophers[i]);
+		snprintf(label, sizeof(label), "%d", i + 1);
+		if (sim->options.stats_format == STATS_JSON)
+			print_json_row(i + 1, get_meals_eaten(&sim->philosophers[i]),
+				&sim->stats[i], FALSE);
+		else
+			print_table_row(label, get_meals_eaten(&sim->philosophers[i]),
+				&sim->stats[i]);
+	}
+	if (sim->options.stats_format == STATS_JSON)
+		print_json_row(0, meals, &total, TRUE);
+	else
+		print_table_row("all", meals, &total);
+	if (sim->options.stats_format == STATS_JSON)
+		fprintf(stderr, "]\n");
+}
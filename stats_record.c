@@ -0,0 +1,81 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats_record.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:47:40 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:23:54 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Records the time a philosopher was blocked on one fork.
+ * 
+ * Like every stats_record_*() function, this writes only to the calling
+ * thread's own cache-aligned slot, with plain non-atomic updates.
+ * 
+ * @param stats The calling philosopher's slot.
+ * @param event LOG_TAKEN_LEFT_FORK, or any other fork event for the right.
+ * @param wait_ns Time spent in pthread_mutex_lock(), in nanoseconds.
+ */
+void	stats_record_fork_wait(t_philo_stats *stats, int event,
+	long long wait_ns)
+{
+	if (event == LOG_TAKEN_LEFT_FORK)
+	{
+		stats->left_fork_wait_ns += wait_ns;
+		stats->left_fork_locks++;
+	}
+	else
+	{
+		stats->right_fork_wait_ns += wait_ns;
+		stats->right_fork_locks++;
+	}
+}
+
+/**
+ * @brief Records one completed sleep.
+ * 
+ * @param stats The calling philosopher's slot.
+ * @param wakeups Number of futex waits the sleep needed.
+ * @param oversleep_ns How far past its deadline the sleep returned.
+ */
+void	stats_record_sleep(t_philo_stats *stats, long wakeups,
+	long long oversleep_ns)
+{
+	stats->sleeps++;
+	stats->sleep_wakeups += wakeups;
+	stats->oversleep_ns += oversleep_ns;
+	if (oversleep_ns > stats->oversleep_max_ns)
+		stats->oversleep_max_ns = oversleep_ns;
+}
+
+/**
+ * @brief Records one logged event.
+ * 
+ * @param stats The calling philosopher's slot.
+ * @param log_ns Time spent handing the event to the logger.
+ * @param stalls Number of backoffs on a full ring.
+ */
+void	stats_record_log(t_philo_stats *stats, long long log_ns, int stalls)
+{
+	stats->log_events++;
+	stats->log_ns += log_ns;
+	stats->log_stalls += stalls;
+}
+
+/**
+ * @brief Records how long a philosopher went without starting a meal.
+ * 
+ * @param stats The calling philosopher's slot.
+ * @param hunger_ns Time since their previous meal start, or the start.
+ */
+void	stats_record_meal(t_philo_stats *stats, long long hunger_ns)
+{
+	if (hunger_ns > stats->hunger_max_ns)
+		stats->hunger_max_ns = hunger_ns;
+}
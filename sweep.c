@@ -0,0 +1,179 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sweep.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:55:21 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:56:27 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Routine of a sweep worker: runs configurations until none is left.
+ * 
+ * Every run is a complete, quiet simulation on the virtual-time engine
+ * with its own arena, so workers share nothing but the queues and the
+ * result slots they fill.
+ * 
+ * @param arg Pointer to the t_sweep_worker.
+ * @return NULL on thread completion.
+ */
+static void	*sweep_worker_routine(void *arg)
+{
+	t_sweep_worker	*worker;
+	t_bench_config	config;
+	t_options		options;
+	long			index;
+
+	worker = (t_sweep_worker *)arg;
+	options = *worker->sweep->options;
+	options.engine = ENGINE_VIRTUAL;
+	while (sweep_queue_next(worker->sweep, worker->index, &index))
+	{
+		sweep_config(worker->sweep, index, &config);
+		if (bench_run(&options, &config, &worker->sweep->results[index])
+			!= SUCCESS)
+			worker->status = FAILURE;
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Sizes the worker pool and carves its state from the sweep's arena.
+ * 
+ * `--workers=N` if given, otherwise one worker per online CPU, and never
+ * more workers than configurations.
+ * 
+ * @param sweep A parsed sweep.
+ * @return SUCCESS (=0), or FAILURE (=1) after printing an error.
+ */
+static int	sweep_setup(t_sweep *sweep)
+{
+	long	count;
+
+	count = sweep->options->workers;
+	if (count <= 0)
+		count = sysconf(_SC_NPROCESSORS_ONLN);
+	if (count > sweep->count)
+		count = sweep->count;
+	if (count < 1)
+		count = 1;
+	sweep->worker_count = (int)count;
+	if (arena_init(&sweep->arena,
+			arena_span(sizeof(t_bench_result) * sweep->count)
+			+ arena_span(sizeof(t_sweep_queue) * count)
+			+ arena_span(sizeof(t_sweep_worker) * count)) != SUCCESS)
+		return (print_error("Error: Sweep allocation failed.\n"));
+	sweep->results = arena_alloc(&sweep->arena,
+			sizeof(t_bench_result) * sweep->count);
+	sweep->queues = arena_alloc(&sweep->arena, sizeof(t_sweep_queue) * count);
+	sweep->workers = arena_alloc(&sweep->arena,
+			sizeof(t_sweep_worker) * count);
+	sweep_queue_fill(sweep);
+	return (SUCCESS);
+}
+
+/**
+ * @brief Runs the sweep on its workers and waits for all of them.
+ * 
+ * The calling thread is worker 0, and it also runs the share of any
+ * worker whose thread could not be created, by stealing it.
+ * 
+ * @param sweep A sweep that has been set up.
+ * @return SUCCESS (=0), or FAILURE (=1) if any run failed.
+ */
+static int	sweep_execute(t_sweep *sweep)
+{
+	int	status;
+	int	i;
+
+	i = -1;
+	while (++i < sweep->worker_count)
+	{
+		sweep->workers[i].sweep = sweep;
+		sweep->workers[i].index = i;
+		sweep->workers[i].status = SUCCESS;
+		if (i > 0)
+			sweep->workers[i].started = !pthread_create(
+					&sweep->workers[i].thread, NULL, sweep_worker_routine,
+					&sweep->workers[i]);
+	}
+	sweep_worker_routine(&sweep->workers[0]);
+	status = sweep->workers[0].status;
+	while (--i > 0)
+	{
+		if (sweep->workers[i].started)
+			pthread_join(sweep->workers[i].thread, NULL);
+		status |= sweep->workers[i].status;
+	}
+	return (status);
+}
+
+/**
+ * @brief Prints the summary row of one configuration.
+ * 
+ * @param config The configuration.
+ * @param result Its measurements.
+ */
+static void	print_row(const t_bench_config *config,
+	const t_bench_result *result)
+{
+	printf("%5d %5d %5d %5d %5d |", config->philosopher_count,
+		config->time_to_die, config->time_to_eat, config->time_to_sleep,
+		config->required_meals);
+	if (result->death_time >= 0)
+		printf(" %4s %8lld", "no", result->death_time / NS_PER_MS);
+	else
+		printf(" %4s %8s", "yes", "-");
+	printf(" | %9.1f %6d %6d %6.3f\n", result->meals_per_sec,
+		result->min_meals, result->max_meals, result->fairness);
+}
+
+/**
+ * @brief Runs every combination of the `--sweep` ranges and prints one
+ *        summary row per configuration.
+ * 
+ * Configurations run on the virtual-time engine, each for at most
+ * SWEEP_RUN_MS of simulated time, across a work-stealing pool of threads
+ * (sweep_queue.c). Rows are printed in configuration order once every run
+ * is done: N, die, eat, sleep, meals (-1 if unlimited), whether everyone
+ * survived, the time of the first death in ms, meals per simulated
+ * second, fewest and most meals per philosopher and Jain's fairness index.
+ * 
+ * @param options The parsed command-line options.
+ * @param argc The count of positional arguments, plus one for argv[0].
+ * @param argv The positional arguments, starting at argv[1].
+ * @return Returns SUCCESS (=0) if every run completed, otherwise FAILURE (=1).
+ */
+int	run_sweep(const t_options *options, int argc, char *argv[])
+{
+	t_sweep			sweep;
+	t_bench_config	config;
+	long			i;
+
+	memset(&sweep, 0, sizeof(t_sweep));
+	sweep.options = options;
+	if (sweep_parse(&sweep, argc, argv) != SUCCESS
+		|| sweep_setup(&sweep) != SUCCESS)
+		return (FAILURE);
+	if (sweep_execute(&sweep) != SUCCESS)
+	{
+		arena_destroy(&sweep.arena);
+		return (FAILURE);
+	}
+	printf("%5s %5s %5s %5s %5s | %4s %8s | %9s %6s %6s %6s\n", "N", "die",
+		"eat", "sleep", "meals", "ok", "death", "meals/s", "min", "max",
+		"fair");
+	i = -1;
+	while (++i < sweep.count)
+	{
+		sweep_config(&sweep, i, &config);
+		print_row(&config, &sweep.results[i]);
+	}
+	arena_destroy(&sweep.arena);
+	return (SUCCESS);
+}
@@ -0,0 +1,87 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sweep.h                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:54:41 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:56:27 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SWEEP_H
+# define SWEEP_H
+
+# include <pthread.h> // pthread_t
+# include <stdatomic.h> // _Atomic
+# include "arena.h"
+# include "log.h"
+# include "stats.h"
+
+# define SWEEP_PARAMETERS 5 // < N, die, eat, sleep and meals.
+# define SWEEP_MAX_CONFIGS 1000000 // < Most combinations of one sweep.
+# define SWEEP_RUN_MS 60000 // < Simulated length of one sweep run.
+
+/**
+ * @brief Values `lo`, `lo + step`, ... up to `hi` of one parameter.
+ */
+typedef struct s_range
+{
+	int	lo;
+	int	hi;
+	int	step;
+}	t_range;
+
+/**
+ * @brief Configurations still to run by one sweep worker.
+ * 
+ * `next` (low 32 bits) and `end` (high 32 bits) share one word, so the
+ * owner taking `next` and a thief taking the upper half both go through a
+ * single CAS and can never hand out the same configuration twice.
+ */
+typedef struct s_sweep_queue
+{
+	_Alignas(CACHE_LINE_SIZE) _Atomic unsigned long long	span;
+}	t_sweep_queue;
+
+typedef struct s_sweep	t_sweep;
+
+/**
+ * @brief One worker thread of a sweep.
+ */
+typedef struct s_sweep_worker
+{
+	t_sweep		*sweep; // < The sweep it works for.
+	int			index; // < Own queue in `sweep->queues`.
+	int			status; // < SUCCESS, or FAILURE if a run failed.
+	int			started; // < Whether `thread` was created.
+	pthread_t	thread; // < Thread handle of the worker.
+}	t_sweep_worker;
+
+/**
+ * @brief A parameter sweep: every combination of the ranges, run on the
+ *        virtual-time engine across a work-stealing pool of threads.
+ */
+struct s_sweep
+{
+	const struct s_options	*options; // < Options every run starts from.
+	t_range					ranges[SWEEP_PARAMETERS];
+	// ^^^ N, die, eat, sleep and meals; meals is {-1, -1, 1} if not given.
+	long					count; // < Number of configurations.
+	t_bench_result			*results; // < One per configuration.
+	t_sweep_queue			*queues; // < One per worker.
+	t_sweep_worker			*workers; // < The worker threads.
+	int						worker_count; // < Number of workers.
+	t_arena					arena; // < Holds results, queues and workers.
+};
+
+// sweep_range.c
+int		sweep_parse(t_sweep *sweep, int argc, char *argv[]);
+void	sweep_config(const t_sweep *sweep, long index, t_bench_config *config);
+
+// sweep_queue.c
+void	sweep_queue_fill(t_sweep *sweep);
+int		sweep_queue_next(t_sweep *sweep, int index, long *config);
+
+#endif
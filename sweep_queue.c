@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sweep_queue.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:55:07 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:56:27 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Packs a queue's `next` and `end` into one word.
+ * 
+ * @param next First configuration still to run.
+ * @param end One past the last.
+ * @return The packed span.
+ */
+static unsigned long long	span_pack(long next, long end)
+{
+	return ((unsigned long long)end << 32 | (unsigned long long)next);
+}
+
+/**
+ * @brief Hands every worker a contiguous share of the configurations.
+ * 
+ * @param sweep A sweep whose `count`, `queues` and `worker_count` are set.
+ */
+void	sweep_queue_fill(t_sweep *sweep)
+{
+	int	i;
+
+	i = -1;
+	while (++i < sweep->worker_count)
+		atomic_init(&sweep->queues[i].span,
+			span_pack(sweep->count * i / sweep->worker_count,
+				sweep->count * (i + 1) / sweep->worker_count));
+}
+
+/**
+ * @brief Takes the next configuration of a queue.
+ * 
+ * @param queue The queue to take from; normally the caller's own.
+ * @param config Receives the configuration's index.
+ * @return TRUE (=1) if one was taken, FALSE (=0) if the queue is empty.
+ */
+static int	queue_pop(t_sweep_queue *queue, long *config)
+{
+	unsigned long long	span;
+	long				next;
+	long				end;
+
+	span = atomic_load(&queue->span);
+	while (TRUE)
+	{
+		next = (long)(span & 0xFFFFFFFFULL);
+		end = (long)(span >> 32);
+		if (next >= end)
+			return (FALSE);
+		if (atomic_compare_exchange_weak(&queue->span, &span,
+				span_pack(next + 1, end)))
+			break ;
+	}
+	*config = next;
+	return (TRUE);
+}
+
+/**
+ * @brief Steals the upper half of a victim's remaining configurations.
+ * 
+ * The stolen range becomes the thief's own queue, which is empty at that
+ * point, so later thieves can steal from it in turn.
+ * 
+ * @param victim The queue to steal from.
+ * @param own The thief's own, empty queue.
+ * @return TRUE (=1) if anything was stolen, FALSE (=0) otherwise.
+ */
+static int	queue_steal(t_sweep_queue *victim, t_sweep_queue *own)
+{
+	unsigned long long	span;
+	long				next;
+	long				end;
+	long				middle;
+
+	span = atomic_load(&victim->span);
+	while (TRUE)
+	{
+		next = (long)(span & 0xFFFFFFFFULL);
+		end = (long)(span >> 32);
+		if (next >= end)
+			return (FALSE);
+		middle = next + (end - next) / 2;
+		if (atomic_compare_exchange_weak(&victim->span, &span,
+				span_pack(next, middle)))
+			break ;
+	}
+	atomic_store(&own->span, span_pack(middle, end));
+	return (TRUE);
+}
+
+/**
+ * @brief Returns the next configuration a worker should run.
+ * 
+ * The worker runs its own share front to back; once it is empty, it
+ * steals the upper half of the first non-empty queue after its own, so
+ * uneven runs (a death ends a run early, a large N makes it long) keep
+ * every worker busy until the whole sweep is done.
+ * 
+ * @param sweep The sweep.
+ * @param index The calling worker's index.
+ * @param config Receives the configuration's index.
+ * @return TRUE (=1) if there is one, FALSE (=0) once the sweep is done.
+ */
+int	sweep_queue_next(t_sweep *sweep, int index, long *config)
+{
+	t_sweep_queue	*own;
+	int				i;
+
+	own = &sweep->queues[index];
+	while (!queue_pop(own, config))
+	{
+		i = 1;
+		while (i < sweep->worker_count && !queue_steal(
+				&sweep->queues[(index + i) % sweep->worker_count], own))
+			i++;
+		if (i == sweep->worker_count)
+			return (FALSE);
+	}
+	return (TRUE);
+}
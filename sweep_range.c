@@ -0,0 +1,138 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sweep_range.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:54:57 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:56:27 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Reads a positive decimal number and advances past it.
+ * 
+ * @param text The text to read; moved past the digits.
+ * @param value Receives the number.
+ * @return SUCCESS (=0), or FAILURE (=1) without digits, for 0 or on
+ *         overflow.
+ */
+static int	parse_number(const char **text, int *value)
+{
+	long long	number;
+
+	if (**text < '0' || **text > '9')
+		return (FAILURE);
+	number = 0;
+	while (**text >= '0' && **text <= '9' && number <= INT_MAX)
+		number = number * 10 + *(*text)++ - '0';
+	if (number < 1 || number > INT_MAX)
+		return (FAILURE);
+	*value = (int)number;
+	return (SUCCESS);
+}
+
+/**
+ * @brief Parses `LO`, `LO-HI` or `LO-HI:STEP` into a range.
+ * 
+ * @param text The argument to parse.
+ * @param range Receives the range; the step defaults to 1.
+ * @return SUCCESS (=0), or FAILURE (=1) after printing an error.
+ */
+static int	parse_range(const char *text, t_range *range)
+{
+	int	failed;
+
+	range->step = 1;
+	failed = parse_number(&text, &range->lo);
+	range->hi = range->lo;
+	if (!failed && *text == '-')
+	{
+		text++;
+		failed = parse_number(&text, &range->hi);
+		if (!failed && *text == ':')
+		{
+			text++;
+			failed = parse_number(&text, &range->step);
+		}
+	}
+	if (failed || *text || range->hi < range->lo)
+		return (print_error("Error: Invalid sweep range.\n"));
+	return (SUCCESS);
+}
+
+/**
+ * @brief Returns how many values a range covers.
+ * 
+ * @param range The range.
+ * @return The number of values, at least 1.
+ */
+static long	range_size(const t_range *range)
+{
+	return ((range->hi - range->lo) / range->step + 1);
+}
+
+/**
+ * @brief Parses the positional arguments of `--sweep` as ranges.
+ * 
+ * They are the usual `N die eat sleep [meals]`, each either a single
+ * value or a range such as `400-800:50`.
+ * 
+ * @param sweep The sweep; its `ranges` and `count` are filled in.
+ * @param argc The count of positional arguments, plus one for argv[0].
+ * @param argv The positional arguments, starting at argv[1].
+ * @return SUCCESS (=0), or FAILURE (=1) after printing an error.
+ */
+int	sweep_parse(t_sweep *sweep, int argc, char *argv[])
+{
+	int	i;
+
+	if (argc != SWEEP_PARAMETERS && argc != SWEEP_PARAMETERS + 1)
+		return (print_error("Error: Wrong number of arguments\n"));
+	sweep->ranges[SWEEP_PARAMETERS - 1] = (t_range){-1, -1, 1};
+	sweep->count = 1;
+	i = 0;
+	while (++i < argc)
+	{
+		if (parse_range(argv[i], &sweep->ranges[i - 1]) != SUCCESS)
+			return (FAILURE);
+		sweep->count *= range_size(&sweep->ranges[i - 1]);
+		if (sweep->count > SWEEP_MAX_CONFIGS)
+			return (print_error("Error: Too many sweep configurations.\n"));
+	}
+	return (SUCCESS);
+}
+
+/**
+ * @brief Returns configuration `index` of a sweep.
+ * 
+ * The index is read as a mixed-radix number whose last digit is the meal
+ * count, so consecutive configurations differ in the last parameters and
+ * the first parameter (N) changes slowest.
+ * 
+ * @param sweep A parsed sweep.
+ * @param index Index of the configuration, below `sweep->count`.
+ * @param config Receives N, die, eat, sleep, meals and the time limit.
+ */
+void	sweep_config(const t_sweep *sweep, long index, t_bench_config *config)
+{
+	int	values[SWEEP_PARAMETERS];
+	int	i;
+
+	i = SWEEP_PARAMETERS;
+	while (i-- > 0)
+	{
+		values[i] = sweep->ranges[i].lo
+			+ index % range_size(&sweep->ranges[i]) * sweep->ranges[i].step;
+		index /= range_size(&sweep->ranges[i]);
+	}
+	config->philosopher_count = values[0];
+	config->time_to_die = values[1];
+	config->time_to_eat = values[2];
+	config->time_to_sleep = values[3];
+	config->required_meals = values[4];
+	config->time_limit_ms = SWEEP_RUN_MS;
+}
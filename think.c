@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   think.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 09:12:04 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/15 09:12:04 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Tells whether a neighbour needs the shared fork more urgently.
+ * 
+ * Every philosopher has the same `time_to_die`, so the one whose last meal
+ * started earlier dies first. On a tie, which only happens before anybody
+ * has eaten, odd-numbered philosophers go first, as the stagger of the
+ * fixed thinking time had them do.
+ * 
+ * @param philo The thinking philosopher.
+ * @param last_meal Their own last meal start, in nanoseconds.
+ * @param neighbour Index of the neighbour.
+ * @return TRUE (=1) if the neighbour is needier, FALSE (=0) otherwise.
+ */
+static int	is_needier(t_philosopher *philo, long long last_meal,
+	int neighbour)
+{
+	long long	theirs;
+
+	theirs = atomic_load_explicit(
+			&philo->simulation->seats[neighbour].last_meal_time,
+			memory_order_relaxed);
+	if (theirs != last_meal)
+		return (theirs < last_meal);
+	return (philo->id % 2 == 0 && (neighbour + 1) % 2 == 1);
+}
+
+/**
+ * @brief Tells whether either neighbour on the ring is needier.
+ * 
+ * @param philo The thinking philosopher.
+ * @param last_meal Their own last meal start, in nanoseconds.
+ * @return TRUE (=1) if one of them is, FALSE (=0) otherwise.
+ */
+static int	has_needier_neighbour(t_philosopher *philo, long long last_meal)
+{
+	int	count;
+	int	index;
+
+	count = philo->simulation->philosopher_count;
+	index = philo->id - 1;
+	return (is_needier(philo, last_meal, (index + count - 1) % count)
+		|| is_needier(philo, last_meal, (index + 1) % count));
+}
+
+/**
+ * @brief Returns until when a philosopher who starts thinking now may
+ *        leave the forks to a needier neighbour.
+ * 
+ * The philosopher's slack is what they could still wait before they
+ * could no longer eat in time:
+ * `time_to_die - (now - last_meal_time) - time_to_eat`. They may yield
+ * for half of it, and never longer than a meal, so that a neighbour who
+ * is itself blocked cannot make them starve. Only the ring has
+ * neighbours to look at: on other topologies, as for a lone philosopher,
+ * there is nothing to yield to and they get hungry right away.
+ * 
+ * @param philo The thinking philosopher.
+ * @param now Timestamp of the "is thinking" event, or of the start.
+ * @return The end of the yield, `now` or earlier for none.
+ */
+long long	think_until(t_philosopher *philo, long long now)
+{
+	t_simulation	*sim;
+	long long		budget;
+
+	sim = philo->simulation;
+	if (sim->philosopher_count < 2
+		|| sim->options.topology.kind != TOPOLOGY_RING)
+		return (now);
+	budget = (get_last_meal_time(philo) + ms_to_ns(sim->time_to_die) - now
+			- ms_to_ns(sim->time_to_eat)) / 2;
+	if (budget > ms_to_ns(sim->time_to_eat))
+		budget = ms_to_ns(sim->time_to_eat);
+	return (now + budget);
+}
+
+/**
+ * @brief Tells a yielding philosopher when to look at the neighbours
+ *        again, or that the yield is over.
+ * 
+ * @param philo The thinking philosopher.
+ * @param now Current time in nanoseconds.
+ * @param until The end of the yield, from think_until().
+ * @return The time of the next check, at most THINK_SLICE_NS away, or -1
+ *         once the yield ran out or no neighbour is needier any more.
+ */
+long long	think_next_wake(t_philosopher *philo, long long now,
+	long long until)
+{
+	if (now >= until || !has_needier_neighbour(philo,
+			get_last_meal_time(philo)))
+		return (-1);
+	if (now + THINK_SLICE_NS < until)
+		return (now + THINK_SLICE_NS);
+	return (until);
+}
+
+/**
+ * @brief Thinks for as long as a needier neighbour has not eaten yet.
+ * 
+ * A neighbour is needier if their last meal started earlier. Without
+ * one, or without slack, the philosopher gets hungry right away;
+ * otherwise they leave the shared fork to that neighbour and check every
+ * THINK_SLICE_NS whether the neighbour has started eating, for as long as
+ * think_until() allows. The pool engine runs the same controller as a
+ * sequence of think timers (task_think()).
+ * 
+ * The wait sleeps on the end-of-simulation futex, which end_simulation()
+ * wakes.
+ * 
+ * @param philo The thinking philosopher.
+ * @param now Timestamp of the "is thinking" event, or of the start.
+ */
+void	adaptive_think(t_philosopher *philo, long long now)
+{
+	t_simulation	*sim;
+	long long		until;
+	long long		wake;
+
+	sim = philo->simulation;
+	until = think_until(philo, now);
+	wake = think_next_wake(philo, now, until);
+	while (wake >= 0 && !is_simulation_finished(sim))
+	{
+		futex_wait_until(&sim->simulation_ended, FALSE, wake);
+		now = get_time_ns();
+		wake = think_next_wake(philo, now, until);
+	}
+}
@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   timer_wheel.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:52:42 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:12:33 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Empties a wheel and starts it at the given time.
+ * 
+ * @param wheel The wheel to initialize.
+ * @param now Current time in nanoseconds.
+ */
+void	timer_wheel_init(t_timer_wheel *wheel, long long now)
+{
+	memset(wheel, 0, sizeof(t_timer_wheel));
+	wheel->current = now >> WHEEL_TICK_SHIFT;
+}
+
+/**
+ * @brief Links a timer at the head of a slot.
+ * 
+ * @param wheel The wheel that owns the slot.
+ * @param timer The timer to link.
+ * @param slot Index of the slot.
+ */
+static void	link_timer(t_timer_wheel *wheel, t_timer *timer, int slot)
+{
+	timer->slot = slot;
+	timer->next = wheel->slots[slot];
+	if (timer->next)
+		timer->next->pprev = &timer->next;
+	wheel->slots[slot] = timer;
+	timer->pprev = &wheel->slots[slot];
+	if (slot < WHEEL_FAR_SLOT)
+		wheel->occupied[slot / WHEEL_SLOTS] |= 1UL << (slot % WHEEL_SLOTS);
+}
+
+/**
+ * @brief Arms a timer in O(1).
+ * 
+ * The level is the highest digit in which the expiry tick differs from
+ * `current`. A timer that is already due goes into the current tick's
+ * slot, so the next timer_wheel_pop() returns it.
+ * 
+ * @param wheel The wheel to add to.
+ * @param timer A timer that is not armed.
+ * @param expires Absolute expiry time in nanoseconds.
+ */
+void	timer_wheel_add(t_timer_wheel *wheel, t_timer *timer, long long expires)
+{
+	long long	tick;
+	long long	diff;
+	int			level;
+
+	timer->expires = expires;
+	tick = expires >> WHEEL_TICK_SHIFT;
+	if (tick < wheel->current)
+		tick = wheel->current;
+	diff = tick ^ wheel->current;
+	level = 0;
+	while (level < WHEEL_LEVELS && diff >= WHEEL_SLOTS)
+	{
+		diff >>= WHEEL_BITS;
+		level++;
+	}
+	if (level == WHEEL_LEVELS)
+		link_timer(wheel, timer, WHEEL_FAR_SLOT);
+	else
+		link_timer(wheel, timer, level * WHEEL_SLOTS
+			+ ((tick >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1)));
+}
+
+/**
+ * @brief Disarms a timer in O(1); does nothing if it is not armed.
+ * 
+ * @param wheel The wheel the timer was added to.
+ * @param timer The timer to disarm.
+ */
+void	timer_wheel_remove(t_timer_wheel *wheel, t_timer *timer)
+{
+	if (!timer->pprev)
+		return ;
+	*timer->pprev = timer->next;
+	if (timer->next)
+		timer->next->pprev = timer->pprev;
+	if (timer->slot < WHEEL_FAR_SLOT && !wheel->slots[timer->slot])
+		wheel->occupied[timer->slot / WHEEL_SLOTS]
+			&= ~(1UL << (timer->slot % WHEEL_SLOTS));
+	timer->pprev = NULL;
+}
+
+/**
+ * @brief Finds the next slot the wheel has to handle.
+ * 
+ * That is the lowest occupied slot of the lowest non-empty level, handled
+ * at the first tick whose digit on that level reaches the slot. Below
+ * level 0 nothing is occupied, so no lower slot can come first. The far
+ * slot is handled when `current` crosses into the next top-level rotation.
+ * 
+ * @param wheel The wheel to inspect.
+ * @param tick Receives the tick at which the slot is due.
+ * @return Index of the slot, or -1 if the wheel is empty.
+ */
+int	timer_wheel_event(const t_timer_wheel *wheel, long long *tick)
+{
+	int	level;
+	int	digit;
+
+	level = 0;
+	while (level < WHEEL_LEVELS && !wheel->occupied[level])
+		level++;
+	if (level == WHEEL_LEVELS)
+	{
+		if (!wheel->slots[WHEEL_FAR_SLOT])
+			return (-1);
+		*tick = ((wheel->current >> (WHEEL_BITS * WHEEL_LEVELS)) + 1)
+			<< (WHEEL_BITS * WHEEL_LEVELS);
+		return (WHEEL_FAR_SLOT);
+	}
+	digit = __builtin_ctzl(wheel->occupied[level]);
+	*tick = (wheel->current >> (WHEEL_BITS * (level + 1))
+			<< (WHEEL_BITS * (level + 1)))
+		| ((long long)digit << (WHEEL_BITS * level));
+	return (level * WHEEL_SLOTS + digit);
+}
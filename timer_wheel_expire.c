@@ -0,0 +1,121 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   timer_wheel_expire.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 17:57:43 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 18:12:33 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Moves every timer of a higher-level slot down the hierarchy.
+ * 
+ * `current` has just reached the slot, so each timer now differs from it
+ * in a lower digit and is re-added one or more levels further down.
+ * 
+ * @param wheel The wheel being advanced.
+ * @param slot The slot to cascade.
+ */
+static void	cascade(t_timer_wheel *wheel, int slot)
+{
+	t_timer	*timer;
+	t_timer	*next;
+
+	timer = wheel->slots[slot];
+	wheel->slots[slot] = NULL;
+	if (slot < WHEEL_FAR_SLOT)
+		wheel->occupied[slot / WHEEL_SLOTS] &= ~(1UL << (slot % WHEEL_SLOTS));
+	while (timer)
+	{
+		next = timer->next;
+		timer->pprev = NULL;
+		timer_wheel_add(wheel, timer, timer->expires);
+		timer = next;
+	}
+}
+
+/**
+ * @brief Removes and returns one timer that has expired by `now`.
+ * 
+ * Advances `current` from event to event up to the current tick,
+ * cascading higher-level slots on the way. A level-0 slot of a past tick
+ * holds only expired timers; the current tick's slot may also hold timers
+ * due later within the tick, which are left in place. A timer never fires
+ * before its expiry time.
+ * 
+ * Returning one timer at a time lets the caller re-arm or disarm any other
+ * timer, including one that is due as well, before the next call.
+ * 
+ * @param wheel The wheel to advance.
+ * @param now Current time in nanoseconds.
+ * @return An expired, now disarmed timer, or NULL if none is left.
+ */
+t_timer	*timer_wheel_pop(t_timer_wheel *wheel, long long now)
+{
+	t_timer		*timer;
+	long long	tick;
+	int			slot;
+
+	slot = timer_wheel_event(wheel, &tick);
+	while (slot >= 0 && tick <= now >> WHEEL_TICK_SHIFT)
+	{
+		wheel->current = tick;
+		if (slot >= WHEEL_SLOTS)
+			cascade(wheel, slot);
+		else
+		{
+			timer = wheel->slots[slot];
+			while (timer && timer->expires > now)
+				timer = timer->next;
+			if (timer)
+				timer_wheel_remove(wheel, timer);
+			if (timer || tick == now >> WHEEL_TICK_SHIFT)
+				return (timer);
+		}
+		slot = timer_wheel_event(wheel, &tick);
+	}
+	wheel->current = now >> WHEEL_TICK_SHIFT;
+	return (NULL);
+}
+
+/**
+ * @brief Returns when the worker has to call timer_wheel_pop() next.
+ * 
+ * For a slot of the current tick this is the exact earliest expiry in it;
+ * for a later slot, the start of its tick, where it expires or cascades.
+ * Waking up at the returned time never fires a timer late by more than
+ * the caller's own wake-up latency.
+ * 
+ * @param wheel The wheel to inspect.
+ * @param now Current time in nanoseconds.
+ * @return Absolute time in nanoseconds, or LLONG_MAX if the wheel is empty.
+ */
+long long	timer_wheel_next(const t_timer_wheel *wheel, long long now)
+{
+	const t_timer	*timer;
+	long long		tick;
+	long long		next;
+	int				slot;
+
+	slot = timer_wheel_event(wheel, &tick);
+	if (slot < 0)
+		return (LLONG_MAX);
+	if (tick > now >> WHEEL_TICK_SHIFT)
+		return (tick << WHEEL_TICK_SHIFT);
+	if (slot >= WHEEL_SLOTS)
+		return (now);
+	next = LLONG_MAX;
+	timer = wheel->slots[slot];
+	while (timer)
+	{
+		if (timer->expires < next)
+			next = timer->expires;
+		timer = timer->next;
+	}
+	return (next);
+}
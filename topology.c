@@ -0,0 +1,161 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   topology.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:16:14 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:19:54 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Checks that the `--topology` fits the rest of the configuration.
+ * 
+ * Only the thread engine, whose fork locks make no assumption about who
+ * shares a fork, runs other topologies than the ring. A grid or torus
+ * must fill whole rows, and a random philosopher cannot need more forks
+ * than there are.
+ * 
+ * @param sim A configured simulation.
+ * @return SUCCESS (=0), or FAILURE (=1) after printing an error.
+ */
+static int	topology_check(t_simulation *sim)
+{
+	t_topology_spec	*spec;
+
+	spec = &sim->options.topology;
+	if (spec->kind == TOPOLOGY_RING)
+		return (SUCCESS);
+	if (sim->options.engine != ENGINE_THREADS)
+		return (print_error("Error: --topology needs --engine=threads.\n"));
+	if (((spec->kind == TOPOLOGY_GRID || spec->kind == TOPOLOGY_TORUS)
+			&& sim->philosopher_count % spec->param != 0)
+		|| (spec->kind == TOPOLOGY_RANDOM
+			&& (spec->param > sim->philosopher_count
+				|| spec->param > TOPOLOGY_MAX_FORKS)))
+		return (print_error("Error: The topology does not fit the number "
+				"of philosophers.\n"));
+	if (spec->kind == TOPOLOGY_FILE)
+		return (topology_file_load(sim));
+	return (SUCCESS);
+}
+
+/**
+ * @brief Lists the forks of the next philosopher, in ascending order.
+ * 
+ * The ascending order is what lets the hierarchy strategy take any number
+ * of forks without deadlock: every philosopher locks them in the same
+ * global order.
+ * 
+ * @param sim The simulation.
+ * @param cursor Position in the topology file, if there is one.
+ * @param index Index of the philosopher.
+ * @param forks Receives up to TOPOLOGY_MAX_FORKS forks.
+ * @return The number of forks, or -1 if the row is malformed or names a
+ *         fork twice.
+ */
+static int	topology_row(t_simulation *sim, const char **cursor, int index,
+	int *forks)
+{
+	int	count;
+	int	key;
+	int	i;
+	int	j;
+
+	if (sim->options.topology.kind == TOPOLOGY_FILE)
+		count = topology_file_next(cursor, forks);
+	else
+		count = topology_generate(sim, index, forks);
+	i = 0;
+	while (++i < count)
+	{
+		key = forks[i];
+		j = i;
+		while (j > 0 && forks[j - 1] > key)
+		{
+			forks[j] = forks[j - 1];
+			j--;
+		}
+		forks[j] = key;
+		if (j > 0 && forks[j - 1] == key)
+			return (-1);
+	}
+	return (count);
+}
+
+/**
+ * @brief Validates the topology and sizes it, before the arena exists.
+ * 
+ * Walks every philosopher's row once to count the forks, so that the
+ * arena can hold the CSR arrays and a seat for every philosopher and for
+ * every fork: `seat_count` is whichever is more.
+ * 
+ * @param sim A configured simulation.
+ * @return SUCCESS (=0), or FAILURE (=1) after printing an error.
+ */
+int	topology_measure(t_simulation *sim)
+{
+	const char	*cursor;
+	int			forks[TOPOLOGY_MAX_FORKS];
+	int			count;
+	int			i;
+
+	if (topology_check(sim) != SUCCESS)
+		return (FAILURE);
+	cursor = sim->topology.text;
+	sim->topology.total = 0;
+	sim->seat_count = sim->philosopher_count;
+	i = -1;
+	while (++i < sim->philosopher_count)
+	{
+		count = topology_row(sim, &cursor, i, forks);
+		if (count < 1)
+			return (print_error("Error: Invalid topology.\n"));
+		sim->topology.total += count;
+		if (forks[count - 1] >= sim->seat_count)
+			sim->seat_count = forks[count - 1] + 1;
+	}
+	if (cursor && topology_file_next(&cursor, forks) != 0)
+		return (print_error("Error: Invalid topology.\n"));
+	return (SUCCESS);
+}
+
+/**
+ * @brief Builds the CSR arrays in the arena and points every philosopher
+ *        at their row.
+ * 
+ * @param sim A simulation measured with topology_measure(), whose
+ *            philosophers are allocated.
+ * @return SUCCESS (=0), or FAILURE (=1) after printing an error.
+ */
+int	topology_init(t_simulation *sim)
+{
+	t_topology	*topology;
+	const char	*cursor;
+	int			i;
+
+	topology = &sim->topology;
+	topology->offsets = arena_alloc(&sim->arena,
+			sizeof(int) * (sim->philosopher_count + 1));
+	topology->forks = arena_alloc(&sim->arena, sizeof(int) * topology->total);
+	if (!topology->offsets || !topology->forks)
+		return (print_error("Error: Memory allocation failed\n"));
+	cursor = topology->text;
+	topology->offsets[0] = 0;
+	i = -1;
+	while (++i < sim->philosopher_count)
+	{
+		sim->philosophers[i].forks = topology->forks + topology->offsets[i];
+		sim->philosophers[i].fork_count = topology_row(sim, &cursor, i,
+				topology->forks + topology->offsets[i]);
+		topology->offsets[i + 1] = topology->offsets[i]
+			+ sim->philosophers[i].fork_count;
+	}
+	free(topology->text);
+	topology->text = NULL;
+	return (SUCCESS);
+}
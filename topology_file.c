@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   topology_file.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:15:34 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:19:54 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+#include <fcntl.h> // open()
+#include <sys/stat.h> // fstat()
+
+/**
+ * @brief Reads a whole file into a NUL-terminated buffer.
+ * 
+ * @param fd The open file.
+ * @return The contents, to be freed by the caller, or NULL on failure.
+ */
+static char	*read_file(int fd)
+{
+	struct stat	info;
+	char		*text;
+	ssize_t		done;
+	ssize_t		got;
+
+	if (fstat(fd, &info) != 0)
+		return (NULL);
+	text = malloc(info.st_size + 1);
+	done = 0;
+	while (text && done < info.st_size)
+	{
+		got = read(fd, text + done, info.st_size - done);
+		if (got <= 0)
+		{
+			free(text);
+			return (NULL);
+		}
+		done += got;
+	}
+	if (text)
+		text[done] = '\0';
+	return (text);
+}
+
+/**
+ * @brief Loads the `--topology=file:PATH` file.
+ * 
+ * The text stays in `topology.text` until topology_init() has read it a
+ * second time into the arena.
+ * 
+ * @param sim The simulation.
+ * @return SUCCESS (=0), or FAILURE (=1) after printing an error.
+ */
+int	topology_file_load(t_simulation *sim)
+{
+	int	fd;
+
+	fd = open(sim->options.topology.path, O_RDONLY);
+	if (fd >= 0)
+	{
+		sim->topology.text = read_file(fd);
+		close(fd);
+	}
+	if (!sim->topology.text)
+		return (print_error("Error: Cannot read the topology file.\n"));
+	return (SUCCESS);
+}
+
+/**
+ * @brief Skips blanks other than newlines, and a `#` comment.
+ * 
+ * @param cursor Position in the text, moved past what was skipped.
+ */
+static void	skip_blanks(const char **cursor)
+{
+	while (**cursor == ' ' || **cursor == '\t' || **cursor == '\r')
+		(*cursor)++;
+	if (**cursor == '#')
+		while (**cursor && **cursor != '\n')
+			(*cursor)++;
+}
+
+/**
+ * @brief Parses one fork index.
+ * 
+ * @param cursor Position of the first digit, moved past the number.
+ * @return The index, or -1 past TOPOLOGY_MAX_INDEX.
+ */
+static int	parse_fork(const char **cursor)
+{
+	long	value;
+
+	value = 0;
+	while (**cursor >= '0' && **cursor <= '9' && value <= TOPOLOGY_MAX_INDEX)
+		value = value * 10 + *(*cursor)++ - '0';
+	if (value > TOPOLOGY_MAX_INDEX)
+		return (-1);
+	return ((int)value);
+}
+
+/**
+ * @brief Parses the next philosopher's line of a topology file.
+ * 
+ * Line `i` lists, separated by blanks, the forks philosopher `i + 1`
+ * needs. Blank lines and `#` comments are skipped.
+ * 
+ * @param cursor Position in the text, moved past the line.
+ * @param forks Receives up to TOPOLOGY_MAX_FORKS forks.
+ * @return The number of forks, 0 at the end of the text, or -1 for a
+ *         malformed line.
+ */
+int	topology_file_next(const char **cursor, int *forks)
+{
+	int	count;
+
+	count = 0;
+	while (**cursor && count == 0)
+	{
+		skip_blanks(cursor);
+		while (**cursor >= '0' && **cursor <= '9')
+		{
+			if (count == TOPOLOGY_MAX_FORKS)
+				return (-1);
+			forks[count] = parse_fork(cursor);
+			if (forks[count++] < 0)
+				return (-1);
+			skip_blanks(cursor);
+		}
+		if (**cursor && **cursor != '\n')
+			return (-1);
+		if (**cursor)
+			(*cursor)++;
+	}
+	return (count);
+}
@@ -0,0 +1,129 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   topology_gen.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:15:21 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:19:54 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Lists the forks of one philosopher of a grid or torus.
+ * 
+ * Philosophers sit on the nodes of a `width` x `height` grid, row by row,
+ * and every edge between two neighbours is a fork they share: first all
+ * horizontal edges, row by row, then all vertical ones. The torus also
+ * wraps both ways, so everybody there needs four forks.
+ * 
+ * @param sim The simulation.
+ * @param index Index of the philosopher.
+ * @param forks Receives the forks, at most four.
+ * @return The number of forks.
+ */
+static int	grid_forks(t_simulation *sim, int index, int *forks)
+{
+	int	width;
+	int	height;
+	int	wrap;
+	int	row_edges;
+	int	count;
+
+	width = sim->options.topology.param;
+	height = sim->philosopher_count / width;
+	wrap = (sim->options.topology.kind == TOPOLOGY_TORUS);
+	row_edges = width - 1 + wrap;
+	count = 0;
+	if (index % width < width - 1 || wrap)
+		forks[count++] = index / width * row_edges + index % width;
+	if (index % width > 0)
+		forks[count++] = index / width * row_edges + index % width - 1;
+	else if (wrap)
+		forks[count++] = index / width * row_edges + width - 1;
+	if (index / width < height - 1 || wrap)
+		forks[count++] = row_edges * height + index;
+	if (index / width > 0)
+		forks[count++] = row_edges * height + index - width;
+	else if (wrap)
+		forks[count++] = row_edges * height + (height - 1) * width + index;
+	return (count);
+}
+
+/**
+ * @brief Advances a SplitMix64 generator.
+ * 
+ * @param state The generator state.
+ * @return The next 64 pseudo-random bits.
+ */
+static unsigned long long	splitmix(unsigned long long *state)
+{
+	unsigned long long	z;
+
+	*state += 0x9E3779B97F4A7C15ULL;
+	z = *state;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return (z ^ (z >> 31));
+}
+
+/**
+ * @brief Draws the forks of one philosopher of a random topology.
+ * 
+ * Each philosopher needs `param` distinct forks out of one per
+ * philosopher. The generator is seeded from the seed and the index alone,
+ * so a philosopher's forks do not depend on the order they are drawn in.
+ * 
+ * @param sim The simulation; `param` is at most `philosopher_count`.
+ * @param index Index of the philosopher.
+ * @param forks Receives the forks.
+ * @return The number of forks.
+ */
+static int	random_forks(t_simulation *sim, int index, int *forks)
+{
+	unsigned long long	state;
+	int					count;
+	int					fork;
+	int					i;
+
+	state = ((unsigned long long)sim->options.topology.seed << 32) ^ index;
+	count = 0;
+	while (count < sim->options.topology.param)
+	{
+		fork = splitmix(&state) % sim->philosopher_count;
+		i = 0;
+		while (i < count && forks[i] != fork)
+			i++;
+		if (i == count)
+			forks[count++] = fork;
+	}
+	return (count);
+}
+
+/**
+ * @brief Lists the forks of one philosopher of a generated topology.
+ * 
+ * On the ring philosopher `i` needs forks `i` and `i + 1`, wrapping
+ * around; a lone philosopher has only one fork.
+ * 
+ * @param sim The simulation.
+ * @param index Index of the philosopher.
+ * @param forks Receives up to TOPOLOGY_MAX_FORKS forks, in any order.
+ * @return The number of forks.
+ */
+int	topology_generate(t_simulation *sim, int index, int *forks)
+{
+	if (sim->options.topology.kind == TOPOLOGY_GRID
+		|| sim->options.topology.kind == TOPOLOGY_TORUS)
+		return (grid_forks(sim, index, forks));
+	if (sim->options.topology.kind == TOPOLOGY_RANDOM)
+		return (random_forks(sim, index, forks));
+	forks[0] = index;
+	if (sim->philosopher_count == 1)
+		return (1);
+	forks[1] = (index + 1) % sim->philosopher_count;
+	return (2);
+}
@@ -6,7 +6,7 @@
 /*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/06/28 17:38:51 by hoskim            #+#    #+#             */
-/*   Updated: 2025/07/16 00:12:46 by hoskim           ###   ########seoul.kr  */
+/*   Updated: 2026/10/14 19:29:20 by hoskim           ###   ########seoul.kr  */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -65,80 +65,88 @@ int	ft_atoi(const char *str)
 }
 
 /**
- * @brief Gets the current time in milliseconds.
+ * @brief Tells whether an event is left out of the output: every event of
+ *        a quiet run, and those `--output` drops.
  * 
- * This function utilizes the gettimeofday() system call to retrieve the
- * time elapsed since the Unix epoch (1970-01-01 00:00:00 UTC).
- * 
- * The time is stored in a `timeeval` structure, which contains:
- * - tv_sec: The number of seconds.
- * - tv_usec: The number of additional microseconds.
- * 
- * The function then converts these values into a single millisecond value.
- * 
- * @return The current time in milliseconds since the Epoch.
- * @note The second parameter (timezone) of gettimeofday() is set to NULL
- *       because the parameter is not used anymore.
+ * @param sim The simulation.
+ * @param event The event.
+ * @return TRUE (=1) if the event is not logged, FALSE (=0) otherwise.
  */
-long long	get_current_time_ms(void)
+int	is_event_muted(t_simulation *sim, t_log_event event)
 {
-	struct timeval	tv;
-
-	gettimeofday(&tv, NULL);
-	return ((tv.tv_sec * 1000) + (tv.tv_usec / 1000));
+	return (sim->options.quiet || (sim->options.muted_events >> event) & 1);
 }
 
 /**
- * @brief Checks if the simulation has finished.
+ * @brief Logs the current status of a philosopher with `timestamp`.
  * 
- * This function safely checks the `simulation_ended` flag within the
- * `t_simulation` structure using a mutex to ensure thread-safe access.
+ * The event (eating, sleeping, thinking, taking fork, or dying) is stamped
+ * and pushed into the calling thread's log ring; the writer thread formats it
+ * later as "[timestamp] [philosopher_id] [message]". No lock and no stdout
+ * I/O happen on the caller's side. Quiet runs (the benchmark) log nothing,
+ * and neither do events muted by `--output`: they are dropped before the
+ * ring, so they cost no more than the clock reading the caller needs.
+ * Callers that do not need the time use log_philo_status() instead, which
+ * does not read the clock for a muted event.
+ * `--engine=virtual` and `--trace-file` bypass the rings (log_direct()).
+ * PHILO_STATS builds record the time spent here and any stall on a full
+ * ring, which is what used to be time spent waiting for `print_mutex`.
  * 
- * @param sim A pointer to the simulation structure.
- * @return An integer inicating whether the simulation has ended
- *         (1 for finished, 0 for not finished.)
- */
-int	is_simulation_finished(t_simulation *sim)
-{
-	int	finished;
-
-	pthread_mutex_lock(&sim->data_mutex);
-	finished = sim->simulation_ended;
-	pthread_mutex_unlock(&sim->data_mutex);
-	return (finished);
-}
-
-/**
- * @brief Prints the current `status message` of a philosopher with `timestamp`.
- * 
- * This function safely prints philosopher status messages (eating, sleeping,
- * thinking, taking fork, or dying) with proper synchronization using mutex.
- * The output format is: "[timestamp] [philosopher_id] [message]"
+ * The clock is read once, and the reading is returned: a transition's
+ * meal accounting and sleep deadline reuse it instead of reading again,
+ * so e.g. "is eating" and `last_meal_time` are the same instant.
  * 
  * Special handling for death messages:
- * - Death messages are always printed even after simulation ends
- * - Death message automatically sets simulation_ended flag to TRUE
- * - Regular status messages are supperessed once simulation ends
+ * - The death is handed to the writer directly and flushed immediately
+ * - It ends the simulation, so nothing is printed after the death line
+ * - Regular status messages are suppressed once simulation ends
  * 
  * @param philo Pointer to the philosopher structure
- * @param message Status message to print (e.g., "is eating", "died")
- * @param is_death Boolean flag indicating if the status message is
- *                 a death message (1 for death, 0 for normal status)
+ * @param event Status to log (e.g., LOG_EATING, LOG_DIED)
+ * @return The event's timestamp in nanoseconds, on simulation_time()'s
+ *         clock, whether or not the event was logged.
  */
-void	print_timestamp_and_philo_status_msg(
-	t_philosopher *philo, const char *message, int is_dead)
+long long	print_timestamp_and_philo_status_msg(
+	t_philosopher *philo, t_log_event event)
 {
-	long long		elapsed_time;
 	t_simulation	*sim;
+	t_log_record	entry;
+	int				stalls;
 
 	sim = philo->simulation;
-	pthread_mutex_lock(&sim->print_mutex);
-	if (!sim->simulation_ended || is_dead)
+	if (is_event_muted(sim, event))
+		return (simulation_time(sim));
+	if (sim->options.engine == ENGINE_VIRTUAL || sim->logger.file.open)
+		return (log_direct(sim, philo->id, event));
+	entry.philo_id = philo->id;
+	entry.event = event;
+	if (event == LOG_DIED)
 	{
-		elapsed_time = get_current_time_ms() - sim->sim_start_time;
-		printf("%lld %d %s\n", elapsed_time, philo->id, message);
-		if (is_dead == TRUE)
-			sim->simulation_ended = TRUE;
+		end_simulation(sim);
+		entry.timestamp = get_time_ns();
+		log_post_death(&sim->logger, philo->id, entry.timestamp);
+		return (entry.timestamp);
 	}
-	pthread_mutex_unlock(&sim->print_mutex);
+	stalls = log_ring_push(&sim->logger, philo->log_ring, &entry);
+	if (PHILO_STATS)
+		stats_record_log(philo->stats, get_time_ns() - entry.timestamp,
+			stalls);
+	return (entry.timestamp);
+}
+
+/**
+ * @brief Logs a philosopher's status when the caller has no use for the
+ *        event's timestamp.
+ * 
+ * A muted event returns before the clock is read; any other event goes
+ * through print_timestamp_and_philo_status_msg().
+ * 
+ * @param philo Pointer to the philosopher structure
+ * @param event Status to log (e.g., LOG_SLEEPING, LOG_DIED)
+ */
+void	log_philo_status(t_philosopher *philo, t_log_event event)
+{
+	if (is_event_muted(philo->simulation, event))
+		return ;
+	print_timestamp_and_philo_status_msg(philo, event);
 }
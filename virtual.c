@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   virtual.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hoskim <hoskim@student.42prague.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:52:48 by hoskim            #+#    #+#             */
+/*   Updated: 2026/10/14 19:05:31 by hoskim           ###   ########seoul.kr  */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Ends the run once everyone is satisfied or the time limit is
+ *        reached, as the monitor would.
+ * 
+ * @param sim The virtual simulation.
+ * @return TRUE (=1) if the simulation has ended, otherwise FALSE (=0).
+ */
+static int	virtual_finished(t_simulation *sim)
+{
+	if (atomic_load(&sim->satisfied_count) >= sim->philosopher_count
+		|| sim->virtual_now >= sim->stop_time)
+		end_simulation(sim);
+	return (is_simulation_finished(sim));
+}
+
+/**
+ * @brief Starts a virtual simulation at time 0.
+ * 
+ * The pool's single worker holds every task on its timer wheel, and the
+ * tasks start exactly as pool_worker_routine() starts them. No thread is
+ * created.
+ * 
+ * @param sim A prepared simulation with `--engine=virtual`.
+ * @return Always SUCCESS (=0).
+ */
+int	virtual_start(t_simulation *sim)
+{
+	int	i;
+
+	sim->sim_start_time = 0;
+	sim->virtual_now = 0;
+	sim->logger.start_time = 0;
+	timer_wheel_init(&sim->pool.workers[0].wheel, 0);
+	i = -1;
+	while (++i < sim->philosopher_count)
+		task_start(&sim->pool.tasks[i], 0);
+	return (metrics_start(sim));
+}
+
+/**
+ * @brief Runs a virtual simulation to its end on the calling thread.
+ * 
+ * Instead of sleeping until the next timer, the simulated clock jumps to
+ * it: timer_wheel_next() gives the exact earliest expiry within the
+ * current tick, so every eat, sleep and think end and every death
+ * deadline fires at exactly its time and in time order. The pool's task
+ * state machine does the rest, so the rules and the output are those of
+ * `--engine=pool`, minus scheduling noise, and the run is deterministic.
+ * 
+ * @param sim A simulation started with virtual_start().
+ */
+void	virtual_run(t_simulation *sim)
+{
+	t_timer_wheel	*wheel;
+	t_timer			*timer;
+	long long		next;
+
+	wheel = &sim->pool.workers[0].wheel;
+	while (!virtual_finished(sim))
+	{
+		next = timer_wheel_next(wheel, sim->virtual_now);
+		if (next == LLONG_MAX)
+			break ;
+		if (next > sim->stop_time)
+			next = sim->stop_time;
+		if (next > sim->virtual_now)
+			sim->virtual_now = next;
+		timer = timer_wheel_pop(wheel, sim->virtual_now);
+		if (timer)
+			task_expire(timer, sim->virtual_now);
+	}
+	end_simulation(sim);
+	log_flush(&sim->logger);
+}